@@ -0,0 +1,757 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../SpaceGame-SFML/AsteroidPool.h"
+#include "../SpaceGame-SFML/CollisionMask.h"
+#include "../SpaceGame-SFML/Entities.h"
+#include "../SpaceGame-SFML/EntityList.h"
+#include "../SpaceGame-SFML/JobSystem.h"
+#include "../SpaceGame-SFML/MusicPlaylist.h"
+#include "../SpaceGame-SFML/ParticleSystem.h"
+#include "../SpaceGame-SFML/Random.h"
+#include "../SpaceGame-SFML/SpatialGrid.h"
+#include "../SpaceGame-SFML/World.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    // Runs `body` until at least `minSeconds` have passed and returns the average time per run in microseconds
+    template <typename Body>
+    double measure(Body&& body, double minSeconds = 0.25) {
+        int runs = 0;
+        auto start = BenchClock::now();
+        double elapsed = 0.0;
+        do {
+            body();
+            runs++;
+            elapsed = std::chrono::duration<double>(BenchClock::now() - start).count();
+        } while (elapsed < minSeconds);
+        return elapsed * 1e6 / runs;
+    }
+
+    // Like measure(), but runs `setup` untimed before every run of `body`
+    template <typename Setup, typename Body>
+    double measureWithSetup(Setup&& setup, Body&& body, double minSeconds = 0.25) {
+        int runs = 0;
+        double timed = 0.0;
+        auto start = BenchClock::now();
+        do {
+            setup();
+            auto bodyStart = BenchClock::now();
+            body();
+            timed += std::chrono::duration<double>(BenchClock::now() - bodyStart).count();
+            runs++;
+        } while (std::chrono::duration<double>(BenchClock::now() - start).count() < minSeconds);
+        return timed * 1e6 / runs;
+    }
+
+    const float TICK_SECONDS = 1.0f / DEFAULT_TICK_RATE;
+
+    // Reseeded at the start of every benchmark so each one sees the same scene on every run
+    Random benchRandom;
+
+    float randomCoordinate(unsigned int range) {
+        return static_cast<float>(benchRandom.below(range));
+    }
+
+    // Asteroids spread over the playfield, already rotated by a few ticks of movement
+    std::vector<Asteroid> scatterAsteroids(std::size_t count) {
+        WorldConfig config;
+        std::vector<Asteroid> asteroids;
+        asteroids.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            int kind = benchRandom.range(0, 2);
+            Asteroid asteroid(static_cast<AsteroidSize>(kind), config.asteroidSizes[kind], 3.5f, 4.5f);
+            asteroid.appear(benchRandom, benchRandom, width, height);
+            asteroid.setPosition({ randomCoordinate(width), randomCoordinate(height) });
+            for (int step = benchRandom.range(0, 59); step > 0; --step) {
+                asteroid.update(TICK_SECONDS);
+            }
+            asteroids.push_back(asteroid);
+        }
+        return asteroids;
+    }
+
+    // A sprite placed in the playfield, as the collision tests see it
+    struct Placed {
+        const CollisionMask* mask;
+        const CollisionShape* shape;
+        sf::Vector2f position;
+        sf::Vector2f scale;
+        float rotation;
+
+        sf::FloatRect getBounds() const { return computeBounds(position, sf::Vector2f(mask->getSize()), scale, rotation); }
+
+        // Whether the playfield point is on a solid texel, with no rounding of any kind
+        bool covers(sf::Vector2f point) const {
+            float radian = rotation * 3.14159f / 180.0f;
+            sf::Vector2f d = point - position;
+            float u = (d.x * std::cos(radian) + d.y * std::sin(radian)) / scale.x + mask->getSize().x / 2.0f;
+            float v = (d.y * std::cos(radian) - d.x * std::sin(radian)) / scale.y + mask->getSize().y / 2.0f;
+            if (u < 0 || v < 0 || u >= mask->getSize().x || v >= mask->getSize().y) return false;
+            return mask->test(static_cast<int>(u), static_cast<int>(v));
+        }
+    };
+
+    // Reference answer: the shared part of the two boxes sampled four times per pixel each way
+    bool silhouettesOverlap(const Placed& a, const Placed& b) {
+        sf::FloatRect boxA = a.getBounds();
+        sf::FloatRect boxB = b.getBounds();
+        float left = std::max(boxA.position.x, boxB.position.x);
+        float top = std::max(boxA.position.y, boxB.position.y);
+        float right = std::min(boxA.position.x + boxA.size.x, boxB.position.x + boxB.size.x);
+        float bottom = std::min(boxA.position.y + boxA.size.y, boxB.position.y + boxB.size.y);
+        for (float y = top + 0.125f; y < bottom; y += 0.25f) {
+            for (float x = left + 0.125f; x < right; x += 0.25f) {
+                if (a.covers({ x, y }) && b.covers({ x, y })) return true;
+            }
+        }
+        return false;
+    }
+
+    // Made-up stereo songs of known length whose samples say which song and sample they are,
+    // so a listener can tell a dropped, repeated or out-of-place sample
+    class SyntheticTracks : public TrackSource {
+    private:
+        std::vector<std::size_t> lengths;   // in frames
+        std::size_t track = 0;
+        std::size_t position = 0;           // in samples
+
+    public:
+        explicit SyntheticTracks(std::vector<std::size_t> lengths) : lengths(std::move(lengths)) {}
+
+        static std::int16_t sampleAt(std::size_t track, std::size_t index) {
+            return static_cast<std::int16_t>((track * 977 + index) & 0x7FFF);
+        }
+
+        std::size_t getTrackCount() const override { return lengths.size(); }
+        unsigned int getChannelCount() const override { return 2; }
+        unsigned int getSampleRate() const override { return 44100; }
+
+        bool openTrack(std::size_t index) override {
+            track = index;
+            position = 0;
+            return true;
+        }
+
+        std::size_t read(std::int16_t* samples, std::size_t count) override {
+            std::size_t n = std::min(count, lengths[track] * 2 - position);
+            for (std::size_t i = 0; i < n; ++i) {
+                samples[i] = sampleAt(track, position + i);
+            }
+            position += n;
+            return n;
+        }
+    };
+}
+
+void runCollisionBenchmark() {
+    const std::size_t BULLETS = 200;
+    const std::size_t counts[] = { 10, 100, 1000, 10000, 100000 };
+
+    benchRandom = makeRandom(1, RandomStream::Bench);
+    WorldConfig config;
+    Spaceship spaceship(config.shipSize);
+    std::vector<Bullet> bullets;
+    for (std::size_t i = 0; i < BULLETS; ++i) {
+        bullets.emplace_back(config.bulletSize, sf::Vector2f(randomCoordinate(width), randomCoordinate(height)), randomCoordinate(360));
+    }
+
+    std::printf("collision: 1 ship + %zu bullets against N asteroids, time per tick\n", BULLETS);
+    std::printf("%10s %16s %16s %10s %8s\n", "asteroids", "exhaustive (us)", "grid (us)", "speedup", "hits");
+
+    SpatialGrid grid(sf::FloatRect({ -64.0f, -64.0f }, { width + 128.0f, height + 128.0f }), 64.0f);
+    std::vector<sf::FloatRect> boxes;
+    std::vector<std::size_t> candidates;
+
+    for (std::size_t count : counts) {
+        std::vector<Asteroid> asteroids = scatterAsteroids(count);
+
+        // The loops main() used to run: every pair, every transform recomputed per test
+        std::size_t exhaustiveHits = 0;
+        double exhaustive = measure([&] {
+            exhaustiveHits = 0;
+            for (const Asteroid& asteroid : asteroids) {
+                exhaustiveHits += CheckCollision(spaceship.getBounds(), asteroid.getBounds());
+            }
+            for (const Bullet& bullet : bullets) {
+                for (const Asteroid& asteroid : asteroids) {
+                    exhaustiveHits += CheckCollision(bullet.getBounds(), asteroid.getBounds());
+                }
+            }
+        });
+
+        // World's path: boxes cached once, grid rebuilt, exact test on candidates only
+        std::size_t gridHits = 0;
+        double gridTime = measure([&] {
+            gridHits = 0;
+            boxes.resize(asteroids.size());
+            for (std::size_t i = 0; i < asteroids.size(); ++i) {
+                boxes[i] = collisionBox(asteroids[i].getBounds());
+            }
+            grid.build(boxes);
+
+            sf::FloatRect shipBox = collisionBox(spaceship.getBounds());
+            grid.query(shipBox, candidates);
+            for (std::size_t i : candidates) {
+                gridHits += boxesIntersect(shipBox, boxes[i]);
+            }
+            for (const Bullet& bullet : bullets) {
+                sf::FloatRect bulletBox = collisionBox(bullet.getBounds());
+                grid.query(bulletBox, candidates);
+                for (std::size_t i : candidates) {
+                    gridHits += boxesIntersect(bulletBox, boxes[i]);
+                }
+            }
+        });
+
+        std::printf("%10zu %16.1f %16.1f %9.1fx %8zu%s\n", count, exhaustive, gridTime, exhaustive / gridTime,
+            gridHits, gridHits == exhaustiveHits ? "" : "  MISMATCH");
+    }
+}
+
+void runAsteroidUpdateBenchmark() {
+    const std::size_t counts[] = { 1000, 10000, 100000, 1000000 };
+
+    benchRandom = makeRandom(1, RandomStream::Bench);
+    WorldConfig config;
+
+    std::printf("asteroid update: one tick of movement and rotation\n");
+    std::printf("%10s %16s %16s %10s\n", "asteroids", "objects (us)", "pool (us)", "speedup");
+
+    for (std::size_t count : counts) {
+        std::vector<Asteroid> objects = scatterAsteroids(count);
+        AsteroidPool pool(config.asteroidSizes);
+        pool.reserve(count);
+        for (const Asteroid& asteroid : objects) {
+            pool.add(asteroid);
+        }
+
+        double objectTime = measure([&] {
+            for (Asteroid& asteroid : objects) {
+                asteroid.update(TICK_SECONDS);
+            }
+        });
+        double poolTime = measure([&] {
+            pool.update(TICK_SECONDS);
+        });
+
+        // Both ran a different number of ticks; bring them level and check they agree
+        std::vector<Asteroid> check = scatterAsteroids(count);
+        AsteroidPool checkPool(config.asteroidSizes);
+        for (const Asteroid& asteroid : check) {
+            checkPool.add(asteroid);
+        }
+        bool same = true;
+        for (int tick = 0; tick < 100; ++tick) {
+            checkPool.update(TICK_SECONDS);
+            for (Asteroid& asteroid : check) {
+                asteroid.update(TICK_SECONDS);
+            }
+        }
+        for (std::size_t i = 0; i < count && same; ++i) {
+            same = check[i].getPosition() == checkPool.getPosition(i) && check[i].getRotation() == checkPool.getRotation(i);
+        }
+
+        std::printf("%10zu %16.1f %16.1f %9.1fx%s\n", count, objectTime, poolTime, objectTime / poolTime,
+            same ? "" : "  MISMATCH");
+    }
+}
+
+void runRemovalBenchmark() {
+    const std::size_t counts[] = { 1000, 10000, 50000 };
+    const std::size_t deaths[] = { 100, 500 };
+
+    benchRandom = makeRandom(1, RandomStream::Bench);
+    WorldConfig config;
+
+    std::printf("removal: asteroids killed in one tick, time to remove them\n");
+    std::printf("%10s %8s %16s %16s %16s\n", "asteroids", "killed", "erase loop (us)", "EntityList (us)", "pool (us)");
+
+    for (std::size_t count : counts) {
+        std::vector<Asteroid> source = scatterAsteroids(count);
+
+        for (std::size_t killed : deaths) {
+            // Same victims for every container, spread over the whole range
+            std::vector<char> victim(count, 0);
+            for (std::size_t k = 0; k < killed; ) {
+                std::size_t i = benchRandom.below(static_cast<std::uint32_t>(count));
+                if (!victim[i]) {
+                    victim[i] = 1;
+                    k++;
+                }
+            }
+
+            // What main() used to do: erase inside the iteration, shifting the tail every time
+            std::vector<Asteroid> vector;
+            std::vector<char> flags;
+            double eraseTime = measureWithSetup([&] {
+                vector = source;
+                flags = victim;
+            }, [&] {
+                auto flag = flags.begin();
+                for (auto it = vector.begin(); it != vector.end(); ) {
+                    if (*flag) {
+                        it = vector.erase(it);
+                        flag = flags.erase(flag);
+                    }
+                    else {
+                        ++it;
+                        ++flag;
+                    }
+                }
+            });
+
+            EntityList<Asteroid> list;
+            double listTime = measureWithSetup([&] {
+                list.clear();
+                for (const Asteroid& asteroid : source) {
+                    list.add(asteroid);
+                }
+            }, [&] {
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (victim[i]) list.kill(i);
+                }
+                list.compact();
+            });
+
+            AsteroidPool pool(config.asteroidSizes);
+            double poolTime = measureWithSetup([&] {
+                pool.clear();
+                for (const Asteroid& asteroid : source) {
+                    pool.add(asteroid);
+                }
+            }, [&] {
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (victim[i]) pool.kill(i);
+                }
+                pool.compact();
+            });
+
+            bool same = list.size() == count - killed && pool.size() == count - killed && vector.size() == count - killed;
+            std::printf("%10zu %8zu %16.1f %16.1f %16.1f%s\n", count, killed, eraseTime, listTime, poolTime,
+                same ? "" : "  MISMATCH");
+        }
+    }
+}
+
+void runThreadScalingBenchmark() {
+    const int WARMUP_TICKS = 240;
+    const int TICKS = 120;
+
+    // Thousands of asteroids within a few seconds, so the timed ticks are busy from the start
+    WorldConfig config;
+    std::istringstream busy("0 2000 1.0 1 1 2\nlimit asteroids 8000\nlimit rate 2000\n");
+    if (!config.waves.load(busy)) {
+        std::fprintf(stderr, "ERROR: COULD NOT LOAD THE BENCHMARK WAVES\n");
+        return;
+    }
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::printf("threads: World::step with the ship firing, %d ticks after %d of warm-up, seed %llu\n",
+        TICKS, WARMUP_TICKS, static_cast<unsigned long long>(config.seed));
+    std::printf("%8s %10s %16s %10s %18s\n", "threads", "asteroids", "per tick (us)", "speedup", "state hash");
+
+    double singleThreaded = 0.0;
+    std::uint64_t expectedHash = 0;
+    for (unsigned threads : threadCounts) {
+        JobSystem jobs(threads);
+        World world(config);
+        world.setJobSystem(&jobs);
+
+        auto step = [&world] {
+            // Aim sweeps round the ship so bullets go every way
+            float angle = static_cast<float>(world.getTick()) * 0.05f;
+            InputFrame input;
+            input.aim = world.getSpaceship().getPosition() + sf::Vector2f(std::cos(angle), std::sin(angle)) * 200.0f;
+            input.fire = true;
+            world.step(input);
+        };
+
+        for (int tick = 0; tick < WARMUP_TICKS; ++tick) {
+            step();
+        }
+        auto start = BenchClock::now();
+        for (int tick = 0; tick < TICKS; ++tick) {
+            step();
+        }
+        double perTick = std::chrono::duration<double, std::micro>(BenchClock::now() - start).count() / TICKS;
+
+        // The whole simulation state, so any difference threads make to a tick shows up
+        std::uint64_t hash = world.stateHash();
+        if (threads == 1) {
+            singleThreaded = perTick;
+            expectedHash = hash;
+        }
+        std::printf("%8u %10zu %16.1f %9.2fx   %016llx%s\n", threads, world.getAsteroids().size(), perTick, singleThreaded / perTick,
+            static_cast<unsigned long long>(hash), hash == expectedHash ? "" : "  MISMATCH");
+    }
+}
+
+void runMusicBenchmark() {
+    const std::size_t SONGS = 18;
+    const std::size_t FIRST = 5;
+    const int LAPS = 2;
+
+    benchRandom = makeRandom(1, RandomStream::Bench);
+
+    // 1 to 4 seconds each, with one song that ends exactly on a chunk boundary and one empty one
+    std::vector<std::size_t> lengths;
+    for (std::size_t i = 0; i < SONGS; ++i) {
+        lengths.push_back(static_cast<std::size_t>(benchRandom.range(44100, 4 * 44100)));
+    }
+    lengths[3] = 2 * MusicPlaylist::CHUNK_FRAMES;
+    lengths[7] = 0;
+
+    // Every sample the listener should hear, in order: song after song from FIRST, wrapping round
+    std::vector<std::pair<std::size_t, std::size_t>> expected;    // song, samples
+    std::size_t totalSamples = 0;
+    for (int lap = 0; lap < LAPS; ++lap) {
+        for (std::size_t i = 0; i < SONGS; ++i) {
+            std::size_t song = (FIRST + i) % SONGS;
+            expected.push_back({ song, lengths[song] * 2 });
+            totalSamples += lengths[song] * 2;
+        }
+    }
+
+    SyntheticTracks tracks(lengths);
+    MusicPlaylist playlist(tracks, FIRST);
+    NullAudioDevice device(playlist);
+
+    std::size_t part = 0, index = 0, errors = 0;
+    auto listen = [&](std::int16_t sample) {
+        while (part < expected.size() && index == expected[part].second) {
+            part++;
+            index = 0;
+        }
+        if (part == expected.size()) return;
+        if (sample != SyntheticTracks::sampleAt(expected[part].first, index)) errors++;
+        index++;
+    };
+
+    auto start = BenchClock::now();
+    while (device.getSampleCount() < totalSamples && device.pull(listen)) {}
+    double elapsed = std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+
+    std::printf("music: %zu synthetic songs, %d laps through a null audio device\n", SONGS, LAPS);
+    std::printf("%12s %10s %14s %14s %12s %8s\n", "samples", "chunks", "per chunk (us)", "buffer (KiB)", "song starts", "errors");
+    std::printf("%12llu %10llu %14.2f %14.1f %12llu %8zu%s\n",
+        static_cast<unsigned long long>(device.getSampleCount()), static_cast<unsigned long long>(device.getChunkCount()),
+        elapsed / device.getChunkCount(), playlist.getBufferBytes() / 1024.0,
+        static_cast<unsigned long long>(playlist.getTrackStarts()), errors, errors == 0 ? "" : "  GAP OR GLITCH");
+}
+
+void runMaskBenchmark() {
+    const std::size_t PAIRS = 20000;
+    const sf::Vector2f ASTEROID_SCALE = { 3.5f, 4.5f };
+    const sf::Vector2f BULLET_SCALE = { 1.0f, 1.0f };
+
+    benchRandom = makeRandom(1, RandomStream::Bench);
+    WorldConfig config;
+    Spaceship spaceship(config.shipSize);
+
+    CollisionShape shipShape, bulletShape, asteroidShapes[3];
+    double buildTime = measure([&] {
+        shipShape = CollisionShape(config.shipMask, spaceship.getScale());
+        bulletShape = CollisionShape(config.bulletMask, BULLET_SCALE);
+        for (int i = 0; i < 3; ++i) {
+            asteroidShapes[i] = CollisionShape(config.asteroidMasks[i], ASTEROID_SCALE);
+        }
+    });
+    std::size_t bytes = shipShape.getByteCount() + bulletShape.getByteCount();
+    for (const CollisionShape& shape : asteroidShapes) {
+        bytes += shape.getByteCount();
+    }
+
+    std::printf("masks: %zu pairs per mover, within 1.2x the sum of their bounding circles\n", PAIRS);
+    std::printf("shapes built in %.1f ms, %.0f KiB for %d rotations each\n", buildTime / 1000.0, bytes / 1024.0, CollisionShape::ROTATION_STEPS);
+    std::printf("%8s %12s %10s %8s %12s %8s\n", "mover", "test", "ns/pair", "hits", "false hits", "misses");
+
+    struct Mover {
+        const char* name;
+        const CollisionMask* mask;
+        const CollisionShape* shape;
+        sf::Vector2f scale;
+    };
+    const Mover movers[] = {
+        { "ship", &config.shipMask, &shipShape, spaceship.getScale() },
+        { "bullet", &config.bulletMask, &bulletShape, BULLET_SCALE },
+    };
+
+    for (const Mover& mover : movers) {
+        std::vector<std::pair<Placed, Placed>> pairs;
+        std::vector<bool> truth;
+        for (std::size_t i = 0; i < PAIRS; ++i) {
+            int kind = benchRandom.range(0, 2);
+            Placed asteroid = { &config.asteroidMasks[kind], &asteroidShapes[kind], { 400.0f, 400.0f }, ASTEROID_SCALE, benchRandom.uniform(0.0f, 360.0f) };
+
+            float reach = 1.2f * (mover.shape->getRadius() + asteroid.shape->getRadius());
+            float angle = benchRandom.uniform(0.0f, 6.2831853f);
+            float distance = benchRandom.uniform(0.0f, reach);
+            sf::Vector2f position = asteroid.position + sf::Vector2f(std::cos(angle), std::sin(angle)) * distance;
+            Placed placed = { mover.mask, mover.shape, position, mover.scale, benchRandom.uniform(0.0f, 360.0f) };
+
+            pairs.push_back({ placed, asteroid });
+            truth.push_back(silhouettesOverlap(placed, asteroid));
+        }
+
+        auto score = [&](const char* name, auto&& test) {
+            std::size_t hits = 0;
+            double perRun = measure([&] {
+                hits = 0;
+                for (const auto& pair : pairs) {
+                    hits += test(pair.first, pair.second);
+                }
+            });
+
+            std::size_t falseHits = 0, misses = 0;
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                bool hit = test(pairs[i].first, pairs[i].second);
+                falseHits += hit && !truth[i];
+                misses += !hit && truth[i];
+            }
+            std::printf("%8s %12s %10.1f %8zu %12zu %8zu\n", mover.name, name, perRun * 1000.0 / pairs.size(), hits, falseHits, misses);
+        };
+
+        score("exact", silhouettesOverlap);
+        score("box (0.65)", [](const Placed& a, const Placed& b) {
+            return CheckCollision(a.getBounds(), b.getBounds());
+        });
+        score("circles", [](const Placed& a, const Placed& b) {
+            return circlesOverlap(a.position, a.shape->getRadius(), b.position, b.shape->getRadius());
+        });
+        score("mask", [](const Placed& a, const Placed& b) {
+            return shapesOverlap(*a.shape, a.position, a.rotation, *b.shape, b.position, b.rotation);
+        });
+    }
+}
+
+void runSweepBenchmark() {
+    const std::size_t SHOTS = 5000;
+    const float RANGE = 150.0f;     // start and end of every shot, from the asteroid
+    const float speeds[] = { 600.0f, 1200.0f, 2400.0f, 4800.0f };
+    const int tickRates[] = { 120, 60, 30 };
+
+    benchRandom = makeRandom(1, RandomStream::Bench);
+    World world;
+    const CollisionShape& bulletShape = world.getBulletShape();
+    const CollisionShape& asteroidShape = world.getAsteroidShape(AsteroidSize::Small);
+    const sf::Vector2f target = { 400.0f, 400.0f };
+
+    // Shots across a still, turned small asteroid, aimed anywhere within its bounding circle
+    struct Shot {
+        sf::Vector2f start;
+        sf::Vector2f direction;
+        float bulletRotation;
+        float asteroidRotation;
+        bool hits;
+    };
+    std::vector<Shot> shots;
+    std::size_t expectedHits = 0;
+    float reach = bulletShape.getRadius() + asteroidShape.getRadius();
+    for (std::size_t i = 0; i < SHOTS; ++i) {
+        Shot shot;
+        float angle = benchRandom.uniform(0.0f, 6.2831853f);
+        shot.direction = { std::cos(angle), std::sin(angle) };
+        float offset = benchRandom.uniform(-reach, reach);
+        shot.start = target - shot.direction * RANGE + sf::Vector2f(-shot.direction.y, shot.direction.x) * offset;
+        shot.bulletRotation = benchRandom.uniform(0.0f, 360.0f);
+        shot.asteroidRotation = benchRandom.uniform(0.0f, 360.0f);
+
+        shot.hits = false;
+        for (float travelled = 0.0f; travelled <= 2 * RANGE && !shot.hits; travelled += 0.5f) {
+            shot.hits = shapesOverlap(bulletShape, shot.start + shot.direction * travelled, shot.bulletRotation,
+                                      asteroidShape, target, shot.asteroidRotation);
+        }
+        expectedHits += shot.hits;
+        shots.push_back(shot);
+    }
+
+    std::printf("sweep: %zu shots across a small asteroid, %zu of them on it\n", SHOTS, expectedHits);
+    std::printf("%10s %6s %8s %16s %16s %16s\n", "px/s", "Hz", "px/tick", "discrete misses", "swept misses", "swept false");
+
+    for (float speed : speeds) {
+        for (int tickRate : tickRates) {
+            float step = speed / tickRate;
+            std::size_t discreteMisses = 0, sweptMisses = 0, sweptFalse = 0;
+            for (const Shot& shot : shots) {
+                bool discrete = false, swept = false;
+                Sweep asteroidPath = { target, target, shot.asteroidRotation, shot.asteroidRotation };
+                for (float travelled = 0.0f; travelled < 2 * RANGE; travelled += step) {
+                    sf::Vector2f from = shot.start + shot.direction * travelled;
+                    sf::Vector2f to = from + shot.direction * step;
+                    discrete = discrete || shapesOverlap(bulletShape, to, shot.bulletRotation, asteroidShape, target, shot.asteroidRotation);
+
+                    float time;
+                    Sweep path = { from, to, shot.bulletRotation, shot.bulletRotation };
+                    swept = swept || sweepShapes(bulletShape, path, asteroidShape, asteroidPath, time);
+                }
+                discreteMisses += shot.hits && !discrete;
+                sweptMisses += shot.hits && !swept;
+                sweptFalse += !shot.hits && swept;
+            }
+            std::printf("%10.0f %6d %8.1f %16zu %16zu %16zu\n", speed, tickRate, step, discreteMisses, sweptMisses, sweptFalse);
+        }
+    }
+
+    // Cost of one bullet's test per tick against a candidate asteroid, at the game's speed
+    const Shot& shot = shots[0];
+    Sweep path = { target - sf::Vector2f(5.0f, 0.0f), target + sf::Vector2f(5.0f, 0.0f), shot.bulletRotation, shot.bulletRotation };
+    Sweep asteroidPath = { target + sf::Vector2f(20.0f, 20.0f), target + sf::Vector2f(22.0f, 22.0f), 0.0f, 10.0f };
+    std::size_t hits = 0;
+    double swept = measure([&] {
+        for (int i = 0; i < 10000; ++i) {
+            float time;
+            asteroidPath.startRotation = static_cast<float>(i % 360);
+            hits += sweepShapes(bulletShape, path, asteroidShape, asteroidPath, time);
+        }
+    });
+    double discrete = measure([&] {
+        for (int i = 0; i < 10000; ++i) {
+            hits += shapesOverlap(bulletShape, path.end, path.endRotation, asteroidShape, asteroidPath.end, static_cast<float>(i % 360));
+        }
+    });
+    std::printf("near pair at 10 px/tick: discrete %.1f ns, swept %.1f ns (%zu hits)\n", discrete / 10.0, swept / 10.0, hits);
+}
+
+void runWaveBenchmark(const WaveTable& waves, const char* name) {
+    const int SECONDS = 60;
+    const int REPORT_SECONDS = 10;
+
+    WorldConfig config;
+    config.waves = waves;
+    World world(config);
+    JobSystem jobs;
+    if (jobs.getThreadCount() > 1) world.setJobSystem(&jobs);
+
+    std::printf("waves: %d s of play from %s, %u threads, firing all the time, ship never reset\n",
+        SECONDS, name, jobs.getThreadCount());
+    std::printf("%8s %10s %10s %10s %14s %14s %14s\n", "time (s)", "spawns/s", "speed", "asteroids", "avg tick (ms)", "p99 tick (ms)", "max tick (ms)");
+
+    const int ticksPerReport = REPORT_SECONDS * world.getTickRate();
+    std::vector<double> tickTimes;
+    std::size_t peakAsteroids = 0;
+    for (int report = 0; report < SECONDS / REPORT_SECONDS; ++report) {
+        tickTimes.clear();
+        for (int i = 0; i < ticksPerReport; ++i) {
+            // Aim sweeps round the ship so bullets go every way
+            float angle = static_cast<float>(world.getTick()) * 0.05f;
+            InputFrame input;
+            input.aim = world.getSpaceship().getPosition() + sf::Vector2f(std::cos(angle), std::sin(angle)) * 200.0f;
+            input.fire = true;
+
+            auto start = BenchClock::now();
+            world.step(input);
+            tickTimes.push_back(std::chrono::duration<double, std::milli>(BenchClock::now() - start).count());
+            peakAsteroids = std::max(peakAsteroids, world.getAsteroids().size());
+        }
+
+        double total = 0.0;
+        for (double time : tickTimes) total += time;
+        std::sort(tickTimes.begin(), tickTimes.end());
+        const WaveStage& stage = world.getDirector().getStage();
+        std::printf("%8d %10.0f %10.2f %10zu %14.3f %14.3f %14.3f\n", (report + 1) * REPORT_SECONDS, stage.spawnRate, stage.speed,
+            world.getAsteroids().size(), total / tickTimes.size(), tickTimes[tickTimes.size() * 99 / 100], tickTimes.back());
+    }
+    std::printf("peak %zu asteroids; the frame budget at 60 Hz is 16.7 ms\n", peakAsteroids);
+}
+
+void runFragmentBenchmark() {
+    const std::size_t START = 5000;
+    const std::size_t hitCounts[] = { 100, 1000, 4000 };
+    const int TICKS = 60;
+
+    WorldConfig config;
+    std::printf("fragments: %zu large asteroids shot for %d ticks, pool of %zu allocated up front\n", START, TICKS, config.asteroidCapacity);
+    std::printf("%10s %12s %12s %12s %14s %14s %10s\n", "hits/tick", "pieces/tick", "peak alive", "dropped", "avg tick (us)", "max tick (us)", "capacity");
+
+    for (std::size_t hits : hitCounts) {
+        benchRandom = makeRandom(1, RandomStream::Bench);
+        Random physics = makeRandom(1, RandomStream::Physics);
+        AsteroidPool pool(config.asteroidSizes, config.asteroidCapacity);
+        for (std::size_t i = 0; i < START; ++i) {
+            Asteroid asteroid(AsteroidSize::Large, config.asteroidSizes[2], 3.5f, 4.5f);
+            asteroid.appear(benchRandom, physics, width, height);
+            asteroid.setPosition({ randomCoordinate(width), randomCoordinate(height) });
+            pool.add(asteroid);
+        }
+
+        std::size_t pieces = 0, peak = pool.size();
+        double total = 0.0, slowest = 0.0;
+        for (int tick = 0; tick < TICKS; ++tick) {
+            auto start = BenchClock::now();
+
+            // Shoot asteroids that were there at the start of the tick, like the impacts do
+            std::size_t alive = pool.size();
+            for (std::size_t k = 0; k < hits && alive > 0; ++k) {
+                std::size_t i = benchRandom.below(static_cast<std::uint32_t>(alive));
+                if (!pool.isAlive(i)) continue;
+                pool.kill(i);
+                pieces += pool.split(i, physics);
+            }
+            peak = std::max(peak, pool.size());
+            pool.compact();
+            pool.storePrevious();
+            pool.update(TICK_SECONDS);
+
+            double elapsed = std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+            total += elapsed;
+            slowest = std::max(slowest, elapsed);
+        }
+
+        std::printf("%10zu %12.0f %12zu %12llu %14.1f %14.1f %10zu\n", hits, static_cast<double>(pieces) / TICKS, peak,
+            static_cast<unsigned long long>(pool.getDroppedCount()), total / TICKS, slowest, pool.getCapacity());
+    }
+}
+
+void runParticleBenchmark() {
+    const std::size_t counts[] = { 10000, 50000, 100000 };
+    const std::size_t BURST = 48;
+    const int FRAMES = 600;
+
+    std::printf("particles: debris held at a steady count for %d frames of %.1f ms, one triangle each\n", FRAMES, TICK_SECONDS * 1000.0f);
+    std::printf("%10s %12s %12s %12s %14s %14s %12s\n", "particles", "emit (us)", "update (us)", "fill (us)", "update ns/p", "fill ns/p", "upload (KB)");
+
+    for (std::size_t target : counts) {
+        benchRandom = makeRandom(1, RandomStream::Bench);
+        ParticleSystem particles(target);
+        std::vector<sf::Vertex> vertices;
+        vertices.reserve(target * 3);
+
+        double emitting = 0.0, updating = 0.0, filling = 0.0;
+        std::size_t alive = 0;
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            // Explosions at random spots until the count is back up
+            auto start = BenchClock::now();
+            while (particles.size() + BURST <= target) {
+                particles.burst(DEBRIS_PARTICLES, { randomCoordinate(width), randomCoordinate(height) }, BURST);
+            }
+            auto emitted = BenchClock::now();
+            particles.update(TICK_SECONDS);
+            auto updated = BenchClock::now();
+            particles.fill(vertices);
+            auto filled = BenchClock::now();
+
+            emitting += std::chrono::duration<double, std::micro>(emitted - start).count();
+            updating += std::chrono::duration<double, std::micro>(updated - emitted).count();
+            filling += std::chrono::duration<double, std::micro>(filled - updated).count();
+            alive += particles.size();
+        }
+
+        double average = static_cast<double>(alive) / FRAMES;
+        std::printf("%10zu %12.1f %12.1f %12.1f %14.2f %14.2f %12.0f\n", target, emitting / FRAMES, updating / FRAMES, filling / FRAMES,
+            updating * 1000.0 / alive, filling * 1000.0 / alive, average * 3 * sizeof(sf::Vertex) / 1024.0);
+    }
+}
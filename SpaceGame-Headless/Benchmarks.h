@@ -0,0 +1,51 @@
+#pragma once
+#include "../SpaceGame-SFML/WaveDirector.h"
+
+// Micro-benchmarks run with `SpaceGame-Headless --bench <name>`. Each prints a table to stdout.
+
+// Broad phase: exhaustive bullet x asteroid CheckCollision against the SpatialGrid,
+// from 10 to 100k asteroids
+void runCollisionBenchmark();
+
+// Asteroid integration: per-object Asteroid::update() against the AsteroidPool kernel,
+// from 1k to 1M asteroids
+void runAsteroidUpdateBenchmark();
+
+// Removing hundreds of asteroids in one tick: erase-in-loop on a std::vector against
+// EntityList and AsteroidPool kill-then-compact
+void runRemovalBenchmark();
+
+// Whole ticks of a busy World stepped on 1 to N threads with the JobSystem; every thread count
+// must end on the same state hash as one thread
+void runThreadScalingBenchmark();
+
+// Music playback: synthetic songs streamed through a MusicPlaylist into a null audio device;
+// every sample must arrive in order with no gaps between songs, from a fixed-size buffer
+void runMusicBenchmark();
+
+// Narrow phase: ship and bullet against asteroid pairs placed near each other, tested with the
+// old shrunk-box CheckCollision, bounding circles alone and CollisionShape masks; each is timed
+// per pair and scored against a supersampled test of the exact sprite silhouettes
+void runMaskBenchmark();
+
+// Tunnelling: bullets fired past small asteroids at rising speeds and falling tick rates, tested
+// once per tick at the end of the move against swept along the path; both are scored against
+// the path sampled every half pixel
+void runSweepBenchmark();
+
+// Fragmentation: a pool of thousands of asteroids shot hundreds to thousands of times a tick,
+// every large and medium one splitting into pieces appended to the preallocated pool while the
+// hits are resolved. Times the hits, the compaction and the move of each tick.
+void runFragmentBenchmark();
+
+// Particles: explosion debris kept at 10k to 100k live particles, re-emitted as they die out.
+// Times the vectorized update and the fill of the vertices the renderer streams to the GPU.
+void runParticleBenchmark();
+
+// Where the stress preset is, relative to this project's directory
+const char* const STRESS_WAVES_PATH = "../SpaceGame-SFML/Waves/stress.waves";
+
+// Sustained load: a minute of play driven by a wave table (the stress preset by default) with
+// the ship firing all the time and never dying, on every hardware thread. Prints the live
+// asteroids and the tick time every ten seconds of play.
+void runWaveBenchmark(const WaveTable& waves, const char* name);
@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../SpaceGame-SFML/InputRecording.h"
+#include "../SpaceGame-SFML/JobSystem.h"
+#include "../SpaceGame-SFML/Profiler.h"
+#include "../SpaceGame-SFML/SimulationThread.h"
+#include "../SpaceGame-SFML/World.h"
+#include "Benchmarks.h"
+
+// Runs the game simulation without a window, GPU or audio device, for benchmarking and
+// regression checks on build machines:
+//
+//     SpaceGame-Headless --ticks 100000 --seed 42 --input script.txt [--tick-rate 120]
+//
+// Prints the tick rate and a hash of the final state; two runs with the same seed, script and
+// tick rate must print the same hash. Script ticks are simulation ticks at the chosen rate.
+//
+//     SpaceGame-Headless --replay session.sgir
+//
+// plays back a binary recording (from the game's --record, or from `--record` here) with its
+// own seed, tick rate and length, and fails if the final state hash differs from the recorded one.
+// `--bench <name>` runs one of the micro-benchmarks instead, and `--systems` adds the time
+// spent in each system of the tick to the report. `--profile out.csv` profiles every tick as a
+// frame and writes the frame and system times with the entity counts to a CSV file.
+// `--threads N` splits the parallel parts of each tick over N threads (0 for all of them)
+// without changing the hash. `--threaded` steps the world on a simulation thread that hands
+// snapshots to a null renderer on the main thread, the way the game's --threaded mode does;
+// the hash must match an unthreaded run. `--waves file.waves` plays another difficulty curve than
+// the built-in one, which is the game's Waves/default.waves; replay a game recording with the
+// same --waves the game was started with.
+
+namespace {
+    // Stands in for WorldRenderer: reads every snapshot it's handed the way drawing would,
+    // without a window
+    class NullRenderer {
+    private:
+        std::uint64_t frames = 0;
+        std::uint64_t sprites = 0;
+        std::uint64_t lastTick = 0;
+
+    public:
+        void draw(const RenderSnapshot& snapshot) {
+            frames++;
+            sprites += 1 + snapshot.lives + snapshot.asteroids.size() + snapshot.bullets.size() +
+                snapshot.explosions.size() + snapshot.hearts.size();
+            lastTick = snapshot.tick;
+        }
+
+        std::uint64_t getFrames() const { return frames; }
+        std::uint64_t getSprites() const { return sprites; }
+        std::uint64_t getLastTick() const { return lastTick; }
+    };
+
+    void printUsage() {
+        std::cout << "Usage: SpaceGame-Headless [--ticks N] [--seed S] [--input script.txt] [--tick-rate 60|120] [--record out.sgir] [--systems] [--profile out.csv] [--threads N] [--threaded] [--waves file.waves]\n"
+                  << "       SpaceGame-Headless --replay session.sgir\n"
+                  << "       SpaceGame-Headless --bench collision|asteroids|removal|threads|music|masks|sweep|fragments|particles\n"
+                  << "       SpaceGame-Headless --bench waves [file.waves]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned long long ticks = 10000;
+    std::string scriptPath;
+    std::string replayPath;
+    std::string recordPath;
+    bool showSystems = false;
+    std::string profilePath;
+    unsigned threads = 1;
+    bool threaded = false;
+    WorldConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--ticks") == 0 && hasValue) {
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--input") == 0 && hasValue) {
+            scriptPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && hasValue) {
+            recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0 && hasValue) {
+            profilePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--waves") == 0 && hasValue) {
+            if (!config.waves.loadFromFile(argv[++i])) {
+                std::cerr << "ERROR: COULD NOT LOAD WAVES: " << argv[i] << "\n";
+                return -1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--threaded") == 0) {
+            threaded = true;
+        }
+        else if (std::strcmp(argv[i], "--systems") == 0) {
+            showSystems = true;
+        }
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && hasValue) {
+            config.tickRate = std::atoi(argv[++i]);
+            if (config.tickRate <= 0) {
+                printUsage();
+                return -1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--bench") == 0 && hasValue) {
+            std::string name = argv[++i];
+            if (name == "collision") {
+                runCollisionBenchmark();
+                return 0;
+            }
+            if (name == "asteroids") {
+                runAsteroidUpdateBenchmark();
+                return 0;
+            }
+            if (name == "removal") {
+                runRemovalBenchmark();
+                return 0;
+            }
+            if (name == "threads") {
+                runThreadScalingBenchmark();
+                return 0;
+            }
+            if (name == "music") {
+                runMusicBenchmark();
+                return 0;
+            }
+            if (name == "masks") {
+                runMaskBenchmark();
+                return 0;
+            }
+            if (name == "sweep") {
+                runSweepBenchmark();
+                return 0;
+            }
+            if (name == "fragments") {
+                runFragmentBenchmark();
+                return 0;
+            }
+            if (name == "particles") {
+                runParticleBenchmark();
+                return 0;
+            }
+            if (name == "waves") {
+                // An optional wave file follows; the stress preset by default
+                const char* path = i + 1 < argc && argv[i + 1][0] != '-' ? argv[++i] : STRESS_WAVES_PATH;
+                WaveTable waves;
+                if (!waves.loadFromFile(path)) {
+                    std::cerr << "ERROR: COULD NOT LOAD WAVES: " << path << "\n";
+                    return -1;
+                }
+                runWaveBenchmark(waves, path);
+                return 0;
+            }
+            printUsage();
+            return -1;
+        }
+        else {
+            printUsage();
+            return -1;
+        }
+    }
+
+    if (threaded && !profilePath.empty()) {
+        std::cerr << "ERROR: --profile TIMES TICKS ON THE MAIN THREAD AND CAN'T BE USED WITH --threaded\n";
+        return -1;
+    }
+
+    InputScript script;
+    if (!scriptPath.empty() && !script.loadFromFile(scriptPath)) {
+        std::cerr << "ERROR: COULD NOT LOAD INPUT SCRIPT: " << scriptPath << "\n";
+        return -1;
+    }
+
+    InputRecording replay;
+    if (!replayPath.empty()) {
+        if (!replay.loadFromFile(replayPath)) {
+            std::cerr << "ERROR: COULD NOT LOAD INPUT RECORDING: " << replayPath << "\n";
+            return -1;
+        }
+        config.seed = replay.getSeed();
+        config.tickRate = replay.getTickRate();
+        ticks = replay.getTickCount();
+    }
+
+    World world(config);
+    unsigned int deaths = 0;
+
+    // The state hash doesn't depend on the thread count; 0 uses every hardware thread
+    JobSystem jobs(threads);
+    if (jobs.getThreadCount() > 1) world.setJobSystem(&jobs);
+
+    // Keeps every tick up to a million, the last million after that
+    const unsigned long long MAX_PROFILED_TICKS = 1000000;
+    Profiler profiler(profilePath.empty() ? 1 : static_cast<std::size_t>(std::min(ticks, MAX_PROFILED_TICKS)));
+    Profiler* activeProfiler = profilePath.empty() ? nullptr : &profiler;
+    world.setProfiler(activeProfiler);
+
+    InputRecording recording;
+    recording.start(config.seed, config.tickRate);
+
+    auto inputAt = [&](unsigned long long tick) {
+        InputFrame input = replayPath.empty() ? script.at(tick) : replay.at(tick);
+        if (!recordPath.empty()) recording.record(input);
+        return input;
+    };
+
+    NullRenderer nullRenderer;
+    auto start = std::chrono::steady_clock::now();
+    if (threaded) {
+        SimulationThread::Options options;
+        options.realTime = false;
+        options.pauseOnDeath = false;
+        options.tickLimit = ticks;
+
+        SimulationThread simulation(world, inputAt, options);
+        if (ticks > 0) {
+            simulation.start();
+            while (!simulation.isFinished()) {
+                if (simulation.updateSnapshot()) {
+                    nullRenderer.draw(simulation.getSnapshot());
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+            simulation.stop();
+        }
+        deaths = static_cast<unsigned int>(simulation.getDeaths());
+    }
+    else {
+        for (unsigned long long tick = 0; tick < ticks; ++tick) {
+            if (activeProfiler) profiler.beginFrame();
+
+            world.step(inputAt(tick));
+
+            // Same as picking "Play Again" on the death menu
+            if (world.isShipDestroyed()) {
+                deaths++;
+                world.reset();
+            }
+
+            if (activeProfiler) profiler.endFrame(world.getCounts());
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double elapsed = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "ticks:      " << ticks << "\n";
+    std::cout << "seed:       " << world.getSeed() << "\n";
+    std::cout << "threads:    " << jobs.getThreadCount() << "\n";
+    std::cout << "tick rate:  " << world.getTickRate() << " Hz (" << ticks / static_cast<double>(world.getTickRate()) << " s of play)\n";
+    std::cout << "deaths:     " << deaths << "\n";
+    std::cout << "asteroids:  " << world.getAsteroids().size() << "\n";
+    std::cout << "bullets:    peak " << world.getBullets().getHighWaterMark() << " of " << world.getBullets().getCapacity() << "\n";
+    std::cout << "elapsed:    " << std::fixed << std::setprecision(3) << elapsed << " s\n";
+    std::cout << "ticks/sec:  " << std::setprecision(0) << (elapsed > 0.0 ? ticks / elapsed : 0.0) << "\n";
+    if (threaded) {
+        std::cout << "snapshots:  " << nullRenderer.getFrames() << " drawn, " << nullRenderer.getSprites() << " sprites, last tick "
+                  << nullRenderer.getLastTick() << "\n";
+    }
+    std::cout << "state hash: " << std::hex << std::setw(16) << std::setfill('0') << world.stateHash() << std::dec << std::setfill(' ') << "\n";
+
+    if (activeProfiler) {
+        std::cout << std::setprecision(4) << "tick ms:    p50 " << profiler.getFramePercentile(50) << "  p95 " << profiler.getFramePercentile(95)
+                  << "  p99 " << profiler.getFramePercentile(99) << "\n";
+        if (!profiler.writeCsv(profilePath)) {
+            std::cerr << "ERROR: COULD NOT WRITE PROFILE: " << profilePath << "\n";
+            return -1;
+        }
+    }
+
+    if (showSystems) {
+        const SystemTimings& timings = world.getTimings();
+        std::cout << "\n" << std::left << std::setw(14) << "system" << std::right << std::setw(12) << "total (ms)"
+                  << std::setw(14) << "per tick (us)" << std::setw(8) << "share" << "\n";
+        double tickTotal = 0.0;
+        for (int i = 0; i < static_cast<int>(System::RenderPrep); ++i) {
+            tickTotal += timings.getSeconds(static_cast<System>(i));
+        }
+        for (int i = 0; i < static_cast<int>(System::RenderPrep); ++i) {
+            System system = static_cast<System>(i);
+            double seconds = timings.getSeconds(system);
+            std::uint64_t runs = timings.getRuns(system);
+            std::cout << std::left << std::setw(14) << getSystemName(system) << std::right << std::setprecision(2)
+                      << std::setw(12) << seconds * 1e3
+                      << std::setw(14) << (runs > 0 ? seconds * 1e6 / runs : 0.0)
+                      << std::setw(7) << std::setprecision(1) << (tickTotal > 0.0 ? seconds / tickTotal * 100.0 : 0.0) << "%\n";
+        }
+    }
+
+    if (!recordPath.empty()) {
+        recording.finish(world.stateHash());
+        if (!recording.saveToFile(recordPath)) {
+            std::cerr << "ERROR: COULD NOT SAVE INPUT RECORDING: " << recordPath << "\n";
+            return -1;
+        }
+    }
+
+    if (!replayPath.empty()) {
+        if (world.stateHash() != replay.getFinalHash()) {
+            std::cout << "replay:     DESYNC, recorded " << std::hex << std::setw(16) << std::setfill('0') << replay.getFinalHash() << std::dec << "\n";
+            return 1;
+        }
+        std::cout << "replay:     OK (" << replay.getEntryCount() << " input changes)\n";
+    }
+    return 0;
+}
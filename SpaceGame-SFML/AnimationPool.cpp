@@ -0,0 +1,42 @@
+#include "AnimationPool.h"
+#include <algorithm>
+#include <cmath>
+
+std::vector<sf::IntRect> makeFrameTable(const AnimationSpec& spec, const sf::IntRect& sheet) {
+    std::vector<sf::IntRect> frames;
+    for (int frame = 0; frame < spec.frameCount; ++frame) {
+        frames.push_back(sf::IntRect({ sheet.position.x + frame * spec.frameSize.x, sheet.position.y }, spec.frameSize));
+    }
+    return frames;
+}
+
+AnimationPool::AnimationPool(const AnimationSpec& spec, std::size_t capacity, int tickRate)
+    : spec(spec), x(std::max<std::size_t>(capacity, 1)), y(x.size()), startTick(x.size()) {
+    ticksPerFrame = static_cast<std::uint32_t>(std::max(1L, std::lround(spec.frameSeconds * tickRate)));
+}
+
+void AnimationPool::add(sf::Vector2f position, std::uint64_t tick) {
+    if (count == x.size()) {
+        head = slot(1);
+        count--;
+        dropped++;
+    }
+
+    std::size_t i = slot(count);
+    x[i] = position.x;
+    y[i] = position.y;
+    startTick[i] = static_cast<std::uint32_t>(tick);
+    count++;
+}
+
+void AnimationPool::cull(std::uint64_t tick) {
+    while (count > 0 && isFinished(0, tick)) {
+        head = slot(1);
+        count--;
+    }
+}
+
+void AnimationPool::clear() {
+    head = 0;
+    count = 0;
+}
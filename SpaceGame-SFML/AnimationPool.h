@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One kind of one-shot sprite sheet animation: frames laid out left to right in the sheet
+struct AnimationSpec {
+    int frameCount;
+    sf::Vector2i frameSize;
+    float frameSeconds;
+};
+
+const AnimationSpec EXPLOSION_ANIMATION = { 6, { 25, 25 }, 0.1f };     // Explosion.png
+const AnimationSpec HEART_ANIMATION = { 5, { 10, 10 }, 0.1f };         // LifeAnimation.png
+
+// Texture rect of every frame of `spec` in a sheet placed at `sheet`, so drawing a frame is a
+// lookup instead of arithmetic per sprite
+std::vector<sf::IntRect> makeFrameTable(const AnimationSpec& spec, const sf::IntRect& sheet);
+
+// Fixed-capacity ring buffer of running animations of one kind. An animation is only its
+// position and the tick it started on; the frame follows from the current tick, so nothing is
+// updated per tick. Every animation of a kind lasts as long as the others, so they finish in
+// the order they started and culling just moves the start of the ring past the finished ones.
+// When the ring is full the oldest animation, the closest to finishing, makes room.
+class AnimationPool {
+private:
+    AnimationSpec spec;
+    std::uint32_t ticksPerFrame = 1;
+    std::vector<float> x, y;
+    std::vector<std::uint32_t> startTick;   // low 32 bits; elapsed ticks wrap correctly
+    std::size_t head = 0;
+    std::size_t count = 0;
+    std::uint64_t dropped = 0;
+
+    std::size_t slot(std::size_t i) const { return (head + i) % x.size(); }
+    std::uint32_t elapsed(std::size_t i, std::uint64_t tick) const {
+        return static_cast<std::uint32_t>(tick) - startTick[slot(i)];
+    }
+
+public:
+    AnimationPool(const AnimationSpec& spec, std::size_t capacity, int tickRate);
+
+    void add(sf::Vector2f position, std::uint64_t tick);
+
+    // Drops the animations that have played their last frame by `tick`
+    void cull(std::uint64_t tick);
+
+    void clear();
+
+    // Running animations, oldest first
+    std::size_t size() const { return count; }
+    sf::Vector2f getPosition(std::size_t i) const { return { x[slot(i)], y[slot(i)] }; }
+    std::uint32_t getStartTick(std::size_t i) const { return startTick[slot(i)]; }
+    int getFrame(std::size_t i, std::uint64_t tick) const { return static_cast<int>(elapsed(i, tick) / ticksPerFrame); }
+    bool isFinished(std::size_t i, std::uint64_t tick) const { return getFrame(i, tick) >= spec.frameCount; }
+
+    const AnimationSpec& getSpec() const { return spec; }
+    std::size_t getCapacity() const { return x.size(); }
+
+    // Animations cut short because the ring was full
+    std::uint64_t getDroppedCount() const { return dropped; }
+};
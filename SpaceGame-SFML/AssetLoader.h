@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A loaded asset that may still be on its way. Copies share the same result.
+template <typename T>
+class AssetHandle {
+private:
+    std::shared_future<std::shared_ptr<T>> future;
+
+public:
+    AssetHandle() = default;
+    explicit AssetHandle(std::shared_future<std::shared_ptr<T>> future) : future(std::move(future)) {}
+
+    // False for a handle that was never given a load
+    bool isValid() const { return future.valid(); }
+
+    // True once the load has finished; never blocks
+    bool isReady() const {
+        return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // Blocks until the load has finished. Null if the load failed.
+    std::shared_ptr<T> wait() const { return future.get(); }
+};
+
+// Runs asset loads (file I/O, decoding, seeking into the music) on background threads so the
+// window can show and take input while they happen. load() returns right away with a handle
+// the caller polls or waits on. Loads shouldn't touch the GPU or anything the main thread
+// uses; they hand back CPU-side data for the main thread to upload.
+class AssetLoader {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+
+    std::atomic<std::size_t> submitted{ 0 };
+    std::atomic<std::size_t> completed{ 0 };
+
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+
+public:
+    explicit AssetLoader(unsigned threadCount = 2);
+
+    // Finishes the loads already queued before returning
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Runs `load` on a loader thread; it returns a std::shared_ptr<T>, or null when it fails
+    template <typename T, typename Function>
+    AssetHandle<T> load(Function&& load) {
+        auto task = std::make_shared<std::packaged_task<std::shared_ptr<T>()>>(std::forward<Function>(load));
+        AssetHandle<T> handle(task->get_future().share());
+        enqueue([task] { (*task)(); });
+        return handle;
+    }
+
+    std::size_t getSubmittedCount() const { return submitted; }
+    std::size_t getCompletedCount() const { return completed; }
+    bool isIdle() const { return completed == submitted; }
+};
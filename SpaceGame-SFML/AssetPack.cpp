@@ -0,0 +1,160 @@
+#include "AssetPack.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    const char MAGIC[4] = { 'S', 'G', 'A', 'P' };
+    const std::uint16_t VERSION = 1;
+    const std::size_t ALIGNMENT = 16;
+
+    // Bytes of one index entry, not counting its name
+    const std::size_t ENTRY_SIZE = 1 + 2 + 8 + 8 + 4 * 4;
+
+    std::size_t alignUp(std::size_t value) {
+        return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    void writeInteger(std::ofstream& file, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    // Reads the index straight out of the mapped file, checking every read against its end
+    class Reader {
+    private:
+        const std::uint8_t* position;
+        const std::uint8_t* end;
+
+    public:
+        Reader(const std::uint8_t* data, std::size_t size) : position(data), end(data + size) {}
+
+        bool readInteger(std::uint64_t& value, int bytes) {
+            if (end - position < bytes) return false;
+            value = 0;
+            for (int i = 0; i < bytes; ++i) {
+                value |= static_cast<std::uint64_t>(position[i]) << (8 * i);
+            }
+            position += bytes;
+            return true;
+        }
+
+        bool readBytes(std::string& value, std::size_t count) {
+            if (static_cast<std::size_t>(end - position) < count) return false;
+            value.assign(reinterpret_cast<const char*>(position), count);
+            position += count;
+            return true;
+        }
+    };
+}
+
+const char* AssetPack::ATLAS = "atlas";
+
+bool AssetPack::open(const std::filesystem::path& path) {
+    entries.clear();
+    if (!file.open(path)) return false;
+
+    Reader reader(file.getData(), file.getSize());
+    std::string magic;
+    std::uint64_t version = 0, entryCount = 0;
+    if (!reader.readBytes(magic, sizeof(MAGIC)) || std::memcmp(magic.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        !reader.readInteger(version, 2) || version != VERSION || !reader.readInteger(entryCount, 2)) {
+        file.close();
+        return false;
+    }
+
+    for (std::uint64_t i = 0; i < entryCount; ++i) {
+        std::uint64_t kind, nameLength, offset, size, x, y, w, h;
+        std::string name;
+        if (!reader.readInteger(kind, 1) || !reader.readInteger(nameLength, 2) || !reader.readBytes(name, nameLength) ||
+            !reader.readInteger(offset, 8) || !reader.readInteger(size, 8) || !reader.readInteger(x, 4) ||
+            !reader.readInteger(y, 4) || !reader.readInteger(w, 4) || !reader.readInteger(h, 4) ||
+            offset > file.getSize() || size > file.getSize() - offset) {
+            entries.clear();
+            file.close();
+            return false;
+        }
+
+        Entry entry;
+        entry.kind = static_cast<Kind>(kind);
+        entry.data = file.getData() + offset;
+        entry.size = static_cast<std::size_t>(size);
+        entry.rect = sf::IntRect({ static_cast<std::int32_t>(x), static_cast<std::int32_t>(y) },
+                                 { static_cast<std::int32_t>(w), static_cast<std::int32_t>(h) });
+
+        // An image has to hold all of its pixels, or uploading it would read past the data
+        if (entry.kind == Kind::Image && entry.size < static_cast<std::size_t>(entry.rect.size.x) * entry.rect.size.y * 4) {
+            entries.clear();
+            file.close();
+            return false;
+        }
+        entries[name] = entry;
+    }
+    return true;
+}
+
+const AssetPack::Entry* AssetPack::find(const std::string& name) const {
+    auto it = entries.find(name);
+    return it != entries.end() ? &it->second : nullptr;
+}
+
+void AssetPackWriter::addImage(const std::string& name, const sf::Image& image) {
+    sf::Vector2u size = image.getSize();
+    const std::uint8_t* pixels = image.getPixelsPtr();
+    Entry entry{ name, AssetPack::Kind::Image, sf::IntRect({ 0, 0 }, sf::Vector2i(size)), {} };
+    if (pixels) entry.data.assign(pixels, pixels + static_cast<std::size_t>(size.x) * size.y * 4);
+    entries.push_back(std::move(entry));
+}
+
+void AssetPackWriter::addRegion(const std::string& name, const sf::IntRect& rect) {
+    entries.push_back({ name, AssetPack::Kind::Region, rect, {} });
+}
+
+bool AssetPackWriter::addFile(const std::string& name, const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    Entry entry{ name, AssetPack::Kind::Blob, sf::IntRect(), {} };
+    entry.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    entries.push_back(std::move(entry));
+    return true;
+}
+
+bool AssetPackWriter::saveToFile(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    std::size_t indexSize = sizeof(MAGIC) + 2 + 2;
+    for (const Entry& entry : entries) {
+        indexSize += ENTRY_SIZE + entry.name.size();
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeInteger(file, VERSION, 2);
+    writeInteger(file, entries.size(), 2);
+
+    std::size_t offset = alignUp(indexSize);
+    for (const Entry& entry : entries) {
+        writeInteger(file, static_cast<std::uint8_t>(entry.kind), 1);
+        writeInteger(file, entry.name.size(), 2);
+        file.write(entry.name.data(), static_cast<std::streamsize>(entry.name.size()));
+        writeInteger(file, entry.data.empty() ? 0 : offset, 8);
+        writeInteger(file, entry.data.size(), 8);
+        writeInteger(file, static_cast<std::uint32_t>(entry.rect.position.x), 4);
+        writeInteger(file, static_cast<std::uint32_t>(entry.rect.position.y), 4);
+        writeInteger(file, static_cast<std::uint32_t>(entry.rect.size.x), 4);
+        writeInteger(file, static_cast<std::uint32_t>(entry.rect.size.y), 4);
+        offset = alignUp(offset + entry.data.size());
+    }
+
+    std::size_t written = indexSize;
+    for (const Entry& entry : entries) {
+        if (entry.data.empty()) continue;
+        for (; written < alignUp(written); ++written) file.put('\0');
+        file.write(reinterpret_cast<const char*>(entry.data.data()), static_cast<std::streamsize>(entry.data.size()));
+        written += entry.data.size();
+    }
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// All startup assets in one file, built offline with `SpaceGame-SFML --build-pack`: images
+// already decoded to RGBA (the sprite atlas comes packed), the regions of each sprite in it,
+// and raw files such as the font. Opening a pack maps it into memory and reads the index;
+// the data is used in place, so nothing is decoded or copied before it reaches the GPU.
+//
+// Layout, little-endian:
+//
+//     "SGAP"  u16 version  u16 entryCount
+//     entryCount x { u8 kind  u16 nameLength  name  u64 offset  u64 size  i32 x  i32 y  i32 width  i32 height }
+//     data of every entry, each starting at a multiple of 16 bytes from the start of the file
+//
+// Images use width and height; regions have no data, only a rectangle in the "atlas" image.
+class AssetPack {
+public:
+    enum class Kind : std::uint8_t { Image = 1, Region = 2, Blob = 3 };
+
+    struct Entry {
+        Kind kind = Kind::Blob;
+        const std::uint8_t* data = nullptr;     // points into the mapped file
+        std::size_t size = 0;
+        sf::IntRect rect;                       // images: { 0, 0, width, height }
+    };
+
+    // Name of the packed sprite atlas image
+    static const char* ATLAS;
+
+private:
+    MappedFile file;
+    std::map<std::string, Entry> entries;
+
+public:
+    // Maps the pack and reads its index; false if it's missing or malformed
+    [[nodiscard]] bool open(const std::filesystem::path& path);
+
+    bool isOpen() const { return file.isOpen(); }
+
+    // Null if the pack has no entry by that name
+    const Entry* find(const std::string& name) const;
+
+    const std::map<std::string, Entry>& getEntries() const { return entries; }
+    std::size_t getFileSize() const { return file.getSize(); }
+};
+
+// Collects assets and writes them out as an AssetPack
+class AssetPackWriter {
+private:
+    struct Entry {
+        std::string name;
+        AssetPack::Kind kind;
+        sf::IntRect rect;
+        std::vector<std::uint8_t> data;
+    };
+    std::vector<Entry> entries;
+
+public:
+    void addImage(const std::string& name, const sf::Image& image);
+    void addRegion(const std::string& name, const sf::IntRect& rect);
+
+    // Stores a file as it is; false if it can't be read
+    [[nodiscard]] bool addFile(const std::string& name, const std::filesystem::path& path);
+
+    [[nodiscard]] bool saveToFile(const std::filesystem::path& path) const;
+};
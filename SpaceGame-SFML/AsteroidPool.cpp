@@ -0,0 +1,163 @@
+#include "AsteroidPool.h"
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ASTEROID_KERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASTEROID_KERNEL_SSE2
+#endif
+
+AsteroidPool::AsteroidPool(const sf::Vector2f (&textureSizes)[3], std::size_t capacity)
+    : sizes{ textureSizes[0], textureSizes[1], textureSizes[2] }, capacity(capacity) {
+    reserve(capacity);
+}
+
+bool AsteroidPool::add(const Asteroid& asteroid) {
+    if (capacity != 0 && x.size() >= capacity) {
+        dropped++;
+        return false;
+    }
+
+    x.push_back(asteroid.getPosition().x);
+    y.push_back(asteroid.getPosition().y);
+    vx.push_back(asteroid.getVelocity().x);
+    vy.push_back(asteroid.getVelocity().y);
+    angle.push_back(asteroid.getRotation());
+    omega.push_back(asteroid.getRotationSpeed());
+    scaleX.push_back(asteroid.getScaleX());
+    scaleY.push_back(asteroid.getScaleY());
+    kind.push_back(static_cast<std::uint8_t>(asteroid.getKind()));
+    prevX.push_back(asteroid.getPosition().x);
+    prevY.push_back(asteroid.getPosition().y);
+    prevAngle.push_back(asteroid.getRotation());
+    killList.resize(x.size());
+    return true;
+}
+
+std::size_t AsteroidPool::split(std::size_t i, Random& physics) {
+    if (kind[i] == static_cast<std::uint8_t>(AsteroidSize::Small)) return 0;
+
+    AsteroidSize pieceKind = static_cast<AsteroidSize>(kind[i] - 1);
+    std::size_t added = 0;
+    for (int piece = 0; piece < FRAGMENT_COUNT; ++piece) {
+        // Alternate sides so the pieces fly apart
+        float turn = physics.uniform(FRAGMENT_SPREAD / 2, FRAGMENT_SPREAD) * (piece % 2 == 0 ? -1.0f : 1.0f);
+
+        Asteroid fragment(pieceKind, sizes[static_cast<int>(pieceKind)], scaleX[i], scaleY[i]);
+        fragment.breakOff({ x[i], y[i] }, { vx[i], vy[i] }, angle[i], turn, physics);
+        added += add(fragment);
+    }
+    return added;
+}
+
+void AsteroidPool::clear() {
+    resizeArrays(0);
+    killList.clear();
+}
+
+void AsteroidPool::compact() {
+    std::size_t kept = killList.compact([this](std::size_t to, std::size_t from) {
+        x[to] = x[from];
+        y[to] = y[from];
+        vx[to] = vx[from];
+        vy[to] = vy[from];
+        angle[to] = angle[from];
+        omega[to] = omega[from];
+        scaleX[to] = scaleX[from];
+        scaleY[to] = scaleY[from];
+        kind[to] = kind[from];
+        prevX[to] = prevX[from];
+        prevY[to] = prevY[from];
+        prevAngle[to] = prevAngle[from];
+    });
+    resizeArrays(kept);
+}
+
+void AsteroidPool::resizeArrays(std::size_t count) {
+    x.resize(count);
+    y.resize(count);
+    vx.resize(count);
+    vy.resize(count);
+    angle.resize(count);
+    omega.resize(count);
+    scaleX.resize(count);
+    scaleY.resize(count);
+    kind.resize(count);
+    prevX.resize(count);
+    prevY.resize(count);
+    prevAngle.resize(count);
+}
+
+void AsteroidPool::reserve(std::size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    vx.reserve(count);
+    vy.reserve(count);
+    angle.reserve(count);
+    omega.reserve(count);
+    scaleX.reserve(count);
+    scaleY.reserve(count);
+    kind.reserve(count);
+    prevX.reserve(count);
+    prevY.reserve(count);
+    prevAngle.reserve(count);
+    killList.reserve(count);
+}
+
+void AsteroidPool::storePrevious(std::size_t begin, std::size_t end) {
+    std::copy(x.begin() + begin, x.begin() + end, prevX.begin() + begin);
+    std::copy(y.begin() + begin, y.begin() + end, prevY.begin() + begin);
+    std::copy(angle.begin() + begin, angle.begin() + end, prevAngle.begin() + begin);
+}
+
+void AsteroidPool::update(float dt, std::size_t begin, std::size_t end) {
+    // Offset the arrays so the kernel below runs over [0, count)
+    std::size_t count = end - begin;
+    std::size_t i = 0;
+
+    float* px = x.data() + begin;
+    float* py = y.data() + begin;
+    float* pa = angle.data() + begin;
+    const float* pvx = vx.data() + begin;
+    const float* pvy = vy.data() + begin;
+    const float* pw = omega.data() + begin;
+
+    // Rotation speeds are a few hundred degrees per second at most, so one conditional step of 360 keeps the angle
+    // wrapped to [0, 360) the same way Asteroid::update() does
+#if defined(ASTEROID_KERNEL_AVX)
+    const __m256 fullTurn = _mm256_set1_ps(360.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 step = _mm256_set1_ps(dt);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(_mm256_loadu_ps(pvx + i), step)));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(_mm256_loadu_ps(pvy + i), step)));
+
+        __m256 a = _mm256_add_ps(_mm256_loadu_ps(pa + i), _mm256_mul_ps(_mm256_loadu_ps(pw + i), step));
+        a = _mm256_sub_ps(a, _mm256_and_ps(_mm256_cmp_ps(a, fullTurn, _CMP_GE_OQ), fullTurn));
+        a = _mm256_add_ps(a, _mm256_and_ps(_mm256_cmp_ps(a, zero, _CMP_LT_OQ), fullTurn));
+        _mm256_storeu_ps(pa + i, a);
+    }
+#elif defined(ASTEROID_KERNEL_SSE2)
+    const __m128 fullTurn = _mm_set1_ps(360.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 step = _mm_set1_ps(dt);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(pvx + i), step)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(_mm_loadu_ps(pvy + i), step)));
+
+        __m128 a = _mm_add_ps(_mm_loadu_ps(pa + i), _mm_mul_ps(_mm_loadu_ps(pw + i), step));
+        a = _mm_sub_ps(a, _mm_and_ps(_mm_cmpge_ps(a, fullTurn), fullTurn));
+        a = _mm_add_ps(a, _mm_and_ps(_mm_cmplt_ps(a, zero), fullTurn));
+        _mm_storeu_ps(pa + i, a);
+    }
+#endif
+
+    // Scalar tail, or the whole range without SIMD
+    for (; i < count; ++i) {
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+        pa[i] = wrapAngle(pa[i] + pw[i] * dt);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Entities.h"
+#include "EntityList.h"
+
+// Structure-of-arrays storage for the live asteroids. Movement runs as one vectorized pass over
+// contiguous x/y/vx/vy/angle/omega arrays (AVX or SSE2 when the compiler targets them, scalar
+// otherwise; all paths give bit-identical results). Nothing here builds a transform: bounds are
+// computed on demand for collisions and sprites only exist in WorldRenderer. The pose at the
+// start of the tick is kept too, so the renderer can interpolate between ticks.
+class AsteroidPool {
+private:
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> angle, omega;    // degrees, degrees per second
+    std::vector<float> prevX, prevY, prevAngle;
+    std::vector<float> scaleX, scaleY;
+    std::vector<std::uint8_t> kind;     // AsteroidSize
+    sf::Vector2f sizes[3];              // texture size per AsteroidSize
+    KillList killList;
+    std::size_t capacity = 0;           // 0 grows as needed
+    std::uint64_t dropped = 0;
+
+    void resizeArrays(std::size_t count);
+
+public:
+    // A pool built with a capacity allocates its storage once, like EntityList; add() and
+    // split() then never touch the heap and drop what doesn't fit
+    explicit AsteroidPool(const sf::Vector2f (&textureSizes)[3], std::size_t capacity = 0);
+
+    // False when a fixed-capacity pool is full
+    bool add(const Asteroid& asteroid);
+
+    // Appends the pieces asteroid i breaks into when shot (none for a small one) and returns how
+    // many fit. Indices of the asteroids already in the pool stay valid, so this can run while
+    // collisions are being resolved; the pieces take part from the next tick.
+    std::size_t split(std::size_t i, Random& physics);
+    void clear();
+    void reserve(std::size_t count);
+
+    // Remembers the current pose as the one to interpolate from
+    void storePrevious() { storePrevious(0, size()); }
+    void storePrevious(std::size_t begin, std::size_t end);
+
+    // Moves and rotates every asteroid by dt seconds
+    void update(float dt) { update(dt, 0, size()); }
+
+    // Same for the asteroids in [begin, end) only, so chunks can run on different threads
+    void update(float dt, std::size_t begin, std::size_t end);
+
+    // Deferred removal, see KillList
+    void kill(std::size_t i) { killList.kill(i); }
+    bool isAlive(std::size_t i) const { return !killList.isDead(i); }
+    void compact();
+
+    std::size_t size() const { return x.size(); }
+    // Asteroids not killed this tick; equal to size() outside a step
+    std::size_t getAliveCount() const { return x.size() - killList.getDeadCount(); }
+    bool empty() const { return x.empty(); }
+    std::size_t getCapacity() const { return capacity; }
+
+    // Asteroids and pieces left out because the pool was full
+    std::uint64_t getDroppedCount() const { return dropped; }
+
+    sf::Vector2f getPosition(std::size_t i) const { return { x[i], y[i] }; }
+    sf::Vector2f getVelocity(std::size_t i) const { return { vx[i], vy[i] }; }
+    float getRotation(std::size_t i) const { return angle[i]; }
+    sf::Vector2f getPreviousPosition(std::size_t i) const { return { prevX[i], prevY[i] }; }
+    float getPreviousRotation(std::size_t i) const { return prevAngle[i]; }
+    sf::Vector2f getScale(std::size_t i) const { return { scaleX[i], scaleY[i] }; }
+    AsteroidSize getKind(std::size_t i) const { return static_cast<AsteroidSize>(kind[i]); }
+
+    sf::FloatRect getBounds(std::size_t i) const {
+        return computeBounds({ x[i], y[i] }, sizes[kind[i]], { scaleX[i], scaleY[i] }, angle[i]);
+    }
+
+    bool isOutOfScreen(std::size_t i, float windowWidth, float windowHeight, float margin = 50.0f) const {
+        return x[i] < -margin || x[i] > windowWidth + margin ||
+            y[i] < -margin || y[i] > windowHeight + margin;
+    }
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <cmath>
+
+// Axis-aligned bounds of a rectangle of `size` pixels, scaled and rotated around its centre.
+// Gives the same box as sf::Sprite::getGlobalBounds() for a sprite with a centred origin,
+// without needing a texture or a transform.
+inline sf::FloatRect computeBounds(sf::Vector2f position, sf::Vector2f size, sf::Vector2f scale, float rotation) {
+    float radian = rotation * 3.14159f / 180.0f;
+    float cosine = std::abs(std::cos(radian));
+    float sine = std::abs(std::sin(radian));
+
+    float halfWidth = size.x * std::abs(scale.x) / 2.0f;
+    float halfHeight = size.y * std::abs(scale.y) / 2.0f;
+
+    sf::Vector2f half(cosine * halfWidth + sine * halfHeight, sine * halfWidth + cosine * halfHeight);
+    return sf::FloatRect(position - half, half * 2.0f);
+}
+
+const float COLLISION_SCALE = 0.65f;
+
+// Hit box CheckCollision() tests: the bounds shrunk towards their top-left corner
+inline sf::FloatRect collisionBox(sf::FloatRect bounds, float scaleFactor = COLLISION_SCALE) {
+    bounds.size *= scaleFactor;
+    return bounds;
+}
+
+// Same test as FloatRect::findIntersection(), without building the intersection
+inline bool boxesIntersect(const sf::FloatRect& a, const sf::FloatRect& b) {
+    return std::max(a.position.x, b.position.x) < std::min(a.position.x + a.size.x, b.position.x + b.size.x) &&
+        std::max(a.position.y, b.position.y) < std::min(a.position.y + a.size.y, b.position.y + b.size.y);
+}
+
+// When a point moving in a straight line from `start` to `end` over a tick is within `radius`
+// of the origin: the first and last moments, as fractions of the tick in [0, 1]. False if it
+// never gets that close during the tick.
+inline bool sweepCircle(sf::Vector2f start, sf::Vector2f end, float radius, float& enter, float& exit) {
+    sf::Vector2f delta = end - start;
+    float a = delta.x * delta.x + delta.y * delta.y;
+    float b = start.x * delta.x + start.y * delta.y;
+    float c = start.x * start.x + start.y * start.y - radius * radius;
+
+    // Already inside at the start of the tick
+    if (c <= 0.0f) {
+        enter = 0.0f;
+        exit = a > 0.0f ? std::min(1.0f, (-b + std::sqrt(b * b - a * c)) / a) : 1.0f;
+        return true;
+    }
+
+    float discriminant = b * b - a * c;
+    if (a == 0.0f || discriminant <= 0.0f) return false;
+
+    float root = std::sqrt(discriminant);
+    enter = (-b - root) / a;
+    exit = (-b + root) / a;
+    if (enter > 1.0f || exit < 0.0f) return false;
+
+    enter = std::max(enter, 0.0f);
+    exit = std::min(exit, 1.0f);
+    return true;
+}
+
+inline bool CheckCollision(sf::FloatRect bounds1, sf::FloatRect bounds2, float scaleFactor = COLLISION_SCALE) {
+    // Scale the size of the collision box (width and height)
+    bounds1.size *= scaleFactor;
+    bounds2.size *= scaleFactor;
+
+    // Check if the adjusted bounds intersect
+    if (!bounds1.findIntersection(bounds2)) {
+        return false;  // No intersection means no collision
+    }
+    return true;
+}
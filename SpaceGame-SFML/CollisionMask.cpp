@@ -0,0 +1,190 @@
+#include "CollisionMask.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "Collision.h"
+
+namespace {
+    // 64 bits of a mask row starting at column `start`; columns outside the row read as clear
+    std::uint64_t bitsFrom(const std::uint64_t* row, int words, int start) {
+        int word = start >= 0 ? start / 64 : -((63 - start) / 64);
+        int offset = start - word * 64;
+
+        std::uint64_t low = (word >= 0 && word < words) ? row[word] >> offset : 0;
+        std::uint64_t high = (offset != 0 && word + 1 >= 0 && word + 1 < words) ? row[word + 1] << (64 - offset) : 0;
+        return low | high;
+    }
+}
+
+CollisionMask::CollisionMask(sf::Vector2i size)
+    : size(size), words((size.x + 63) / 64), bits(static_cast<std::size_t>(words) * size.y) {
+}
+
+void CollisionMask::fillRows() {
+    for (int y = 0; y < size.y; ++y) {
+        int left = size.x, right = -1;
+        for (int x = 0; x < size.x; ++x) {
+            if (test(x, y)) {
+                left = std::min(left, x);
+                right = x;
+            }
+        }
+        for (int x = left; x <= right; ++x) {
+            set(x, y);
+        }
+    }
+}
+
+CollisionMask CollisionMask::fromPixels(sf::Vector2i size, const std::uint8_t* pixels, std::size_t stride) {
+    if (size.x <= 0 || size.y <= 0 || !pixels) return CollisionMask();
+
+    CollisionMask mask(size);
+    for (int y = 0; y < size.y; ++y) {
+        const std::uint8_t* row = pixels + y * stride;
+        for (int x = 0; x < size.x; ++x) {
+            if (row[x * 4 + 3] >= 128) mask.set(x, y);
+        }
+    }
+    mask.fillRows();
+    return mask;
+}
+
+CollisionMask CollisionMask::fromText(sf::Vector2i size, const char* rows) {
+    if (size.x <= 0 || size.y <= 0 || std::strlen(rows) != static_cast<std::size_t>(size.x) * size.y) return CollisionMask();
+
+    CollisionMask mask(size);
+    for (int y = 0; y < size.y; ++y) {
+        for (int x = 0; x < size.x; ++x) {
+            if (rows[y * size.x + x] == '#') mask.set(x, y);
+        }
+    }
+    mask.fillRows();
+    return mask;
+}
+
+std::string CollisionMask::toText() const {
+    std::string rows;
+    rows.reserve(static_cast<std::size_t>(size.x) * size.y);
+    for (int y = 0; y < size.y; ++y) {
+        for (int x = 0; x < size.x; ++x) {
+            rows += test(x, y) ? '#' : '.';
+        }
+    }
+    return rows;
+}
+
+CollisionShape::CollisionShape(const CollisionMask& mask, sf::Vector2f scale) {
+    if (mask.isEmpty()) return;
+
+    sf::Vector2i textureSize = mask.getSize();
+    sf::Vector2f centre(textureSize.x / 2.0f, textureSize.y / 2.0f);
+    float farthest = 0.0f;
+
+    rotations.resize(ROTATION_STEPS);
+    for (int step = 0; step < ROTATION_STEPS; ++step) {
+        float angle = step * 360.0f / ROTATION_STEPS;
+        float radian = angle * 3.14159f / 180.0f;
+        float cosine = std::cos(radian);
+        float sine = std::sin(radian);
+
+        // Room for the rotated sprite plus a pixel, like sf::Sprite::getGlobalBounds()
+        sf::FloatRect bounds = computeBounds({ 0, 0 }, sf::Vector2f(textureSize), scale, angle);
+        Rotation& rotation = rotations[step];
+        rotation.half = { static_cast<int>(std::ceil(bounds.size.x / 2)) + 1, static_cast<int>(std::ceil(bounds.size.y / 2)) + 1 };
+        rotation.words = (2 * rotation.half.x + 63) / 64;
+        rotation.bits.assign(static_cast<std::size_t>(rotation.words) * 2 * rotation.half.y, 0);
+
+        // Each pixel takes the texel under its centre, turned back into the sprite's frame
+        for (int py = 0; py < 2 * rotation.half.y; ++py) {
+            float dy = py + 0.5f - rotation.half.y;
+            for (int px = 0; px < 2 * rotation.half.x; ++px) {
+                float dx = px + 0.5f - rotation.half.x;
+                float u = (dx * cosine + dy * sine) / scale.x + centre.x;
+                float v = (dy * cosine - dx * sine) / scale.y + centre.y;
+                if (u < 0 || v < 0 || u >= textureSize.x || v >= textureSize.y) continue;
+                if (!mask.test(static_cast<int>(u), static_cast<int>(v))) continue;
+
+                rotation.bits[py * rotation.words + px / 64] |= std::uint64_t(1) << (px % 64);
+
+                // Farthest pixel corner from the centre of the grid
+                float cornerX = static_cast<float>(std::max(std::abs(px - rotation.half.x), std::abs(px + 1 - rotation.half.x)));
+                float cornerY = static_cast<float>(std::max(std::abs(py - rotation.half.y), std::abs(py + 1 - rotation.half.y)));
+                farthest = std::max(farthest, cornerX * cornerX + cornerY * cornerY);
+            }
+        }
+    }
+
+    // The grid is placed at the whole pixel under the position, up to a pixel each way off it
+    radius = std::sqrt(farthest) + 1.5f;
+}
+
+const CollisionShape::Rotation& CollisionShape::at(float rotation) const {
+    int step = static_cast<int>(std::lround(rotation * ROTATION_STEPS / 360.0f)) % ROTATION_STEPS;
+    if (step < 0) step += ROTATION_STEPS;
+    return rotations[step];
+}
+
+std::size_t CollisionShape::getByteCount() const {
+    std::size_t bytes = 0;
+    for (const Rotation& rotation : rotations) {
+        bytes += rotation.bits.size() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+bool shapesOverlap(const CollisionShape& a, sf::Vector2f positionA, float rotationA,
+                   const CollisionShape& b, sf::Vector2f positionB, float rotationB) {
+    if (a.isEmpty() || b.isEmpty()) return false;
+    if (!circlesOverlap(positionA, a.radius, positionB, b.radius)) return false;
+
+    const CollisionShape::Rotation& maskA = a.at(rotationA);
+    const CollisionShape::Rotation& maskB = b.at(rotationB);
+
+    // Top-left pixel of each mask on the playfield
+    int leftA = static_cast<int>(std::floor(positionA.x)) - maskA.half.x;
+    int topA = static_cast<int>(std::floor(positionA.y)) - maskA.half.y;
+    int leftB = static_cast<int>(std::floor(positionB.x)) - maskB.half.x;
+    int topB = static_cast<int>(std::floor(positionB.y)) - maskB.half.y;
+
+    int top = std::max(topA, topB);
+    int bottom = std::min(topA + 2 * maskA.half.y, topB + 2 * maskB.half.y);
+    int left = std::max(leftA, leftB);
+    int right = std::min(leftA + 2 * maskA.half.x, leftB + 2 * maskB.half.x);
+    if (top >= bottom || left >= right) return false;
+
+    // Only A's words touching the overlap are read; B's bits are shifted into line with them,
+    // and B's columns outside the overlap come out clear
+    int firstWord = (left - leftA) / 64;
+    int lastWord = (right - 1 - leftA) / 64;
+    int shift = leftA - leftB;
+    for (int y = top; y < bottom; ++y) {
+        const std::uint64_t* rowA = &maskA.bits[(y - topA) * maskA.words];
+        const std::uint64_t* rowB = &maskB.bits[(y - topB) * maskB.words];
+        for (int word = firstWord; word <= lastWord; ++word) {
+            if (rowA[word] & bitsFrom(rowB, maskB.words, word * 64 + shift)) return true;
+        }
+    }
+    return false;
+}
+
+bool sweepShapes(const CollisionShape& a, const Sweep& sweepA, const CollisionShape& b, const Sweep& sweepB, float& time) {
+    if (a.isEmpty() || b.isEmpty()) return false;
+
+    // A's path as seen from B
+    sf::Vector2f start = sweepA.start - sweepB.start;
+    sf::Vector2f end = sweepA.end - sweepB.end;
+    float enter, exit;
+    if (!sweepCircle(start, end, a.radius + b.radius, enter, exit)) return false;
+
+    sf::Vector2f delta = end - start;
+    float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y) * (exit - enter);
+    int steps = std::max(1, static_cast<int>(std::ceil(distance / SWEEP_STEP)));
+    for (int step = 0; step <= steps; ++step) {
+        float t = enter + (exit - enter) * step / steps;
+        if (shapesOverlap(a, sweepA.at(t), sweepA.rotationAt(t), b, sweepB.at(t), sweepB.rotationAt(t))) {
+            time = t;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Which texels of a sprite are solid, one bit each. The sprites are line art with transparent
+// insides, so every row is solid from its leftmost to its rightmost opaque pixel: a rock or the
+// ship is hit anywhere inside its outline, not only on it.
+class CollisionMask {
+private:
+    sf::Vector2i size;
+    int words = 0;                      // 64-bit words per row
+    std::vector<std::uint64_t> bits;    // bit x % 64 of word x / 64 is column x
+
+    explicit CollisionMask(sf::Vector2i size);
+    void set(int x, int y) { bits[y * words + x / 64] |= std::uint64_t(1) << (x % 64); }
+    void fillRows();
+
+public:
+    CollisionMask() = default;
+
+    // From RGBA pixels with `stride` bytes per row; alpha of 128 or more is opaque
+    static CollisionMask fromPixels(sf::Vector2i size, const std::uint8_t* pixels, std::size_t stride);
+
+    // From `size.y` rows of `size.x` characters back to back, '#' for opaque
+    static CollisionMask fromText(sf::Vector2i size, const char* rows);
+
+    // The rows as fromText() reads them, solid pixels as '#'; the rows come out filled
+    std::string toText() const;
+
+    bool test(int x, int y) const { return (bits[y * words + x / 64] >> (x % 64)) & 1; }
+    sf::Vector2i getSize() const { return size; }
+    bool isEmpty() const { return bits.empty(); }
+
+    bool operator==(const CollisionMask& other) const { return size == other.size && bits == other.bits; }
+};
+
+struct Sweep;
+
+// A mask at the scale an entity is drawn with, rasterized in playfield pixels once per step of
+// rotation, so a test is whole words ANDed together instead of a transform per pixel. 64 steps
+// keep the rim of the largest asteroid within about a texel of where it's drawn.
+class CollisionShape {
+public:
+    static const int ROTATION_STEPS = 64;
+
+private:
+    // The mask turned by one step, covering [-half, half) pixels around the entity's position
+    struct Rotation {
+        sf::Vector2i half;
+        int words = 0;
+        std::vector<std::uint64_t> bits;
+    };
+    std::vector<Rotation> rotations;
+    float radius = 0.0f;
+
+    const Rotation& at(float rotation) const;
+
+    friend bool shapesOverlap(const CollisionShape& a, sf::Vector2f positionA, float rotationA,
+                              const CollisionShape& b, sf::Vector2f positionB, float rotationB);
+    friend bool sweepShapes(const CollisionShape& a, const Sweep& sweepA, const CollisionShape& b, const Sweep& sweepB, float& time);
+
+public:
+    CollisionShape() = default;
+    CollisionShape(const CollisionMask& mask, sf::Vector2f scale);
+
+    // Bounding circle around the entity's position. It holds every rotation of the mask at any
+    // sub-pixel position, so the circle test never rejects a pair the masks would hit.
+    float getRadius() const { return radius; }
+    bool isEmpty() const { return rotations.empty(); }
+
+    // Memory taken by the pre-rotated masks
+    std::size_t getByteCount() const;
+};
+
+// Where an entity is at the start and at the end of a tick; it moves in a straight line and
+// turns the short way round in between
+struct Sweep {
+    sf::Vector2f start;
+    sf::Vector2f end;
+    float startRotation;
+    float endRotation;
+
+    sf::Vector2f at(float time) const { return start + (end - start) * time; }
+    float rotationAt(float time) const {
+        float delta = endRotation - startRotation;
+        if (delta > 180.0f) delta -= 360.0f;
+        if (delta < -180.0f) delta += 360.0f;
+        return startRotation + delta * time;
+    }
+};
+
+inline bool circlesOverlap(sf::Vector2f a, float radiusA, sf::Vector2f b, float radiusB) {
+    sf::Vector2f delta = b - a;
+    float reach = radiusA + radiusB;
+    return delta.x * delta.x + delta.y * delta.y < reach * reach;
+}
+
+// Box around a bounding circle, for the broad phase
+inline sf::FloatRect circleBounds(sf::Vector2f position, float radius) {
+    return sf::FloatRect(position - sf::Vector2f(radius, radius), sf::Vector2f(2 * radius, 2 * radius));
+}
+
+// Test of two shapes at their positions and rotations (degrees): the bounding circles first,
+// then the rows the masks share, a word at a time. Approximate to one rotation step and a
+// pixel: positions snap to whole pixels and rotations to the nearest step, so a pair that only
+// grazes can come out either way (--bench masks counts how often against the exact outlines).
+bool shapesOverlap(const CollisionShape& a, sf::Vector2f positionA, float rotationA,
+                   const CollisionShape& b, sf::Vector2f positionB, float rotationB);
+
+// Continuous test of two shapes over a tick, so a fast mover can't step over a thin one between
+// two ticks. The bounding circles are swept against each other first; the masks are then tested
+// through the part of the tick the circles overlap, SWEEP_STEP pixels of relative motion apart.
+// `time` is the first moment they touch, as a fraction of the tick.
+const float SWEEP_STEP = 2.0f;
+bool sweepShapes(const CollisionShape& a, const Sweep& sweepA, const CollisionShape& b, const Sweep& sweepB, float& time);
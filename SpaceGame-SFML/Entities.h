@@ -0,0 +1,319 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Angle.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cmath>
+#include "Collision.h"
+#include "GameConstants.h"
+#include "Input.h"
+#include "Random.h"
+
+// Simulation-side entities. They hold plain state only (no sprites or textures), so the
+// world can be stepped without a window; WorldRenderer turns them into sprites when drawing.
+
+// Rotation the way sf::Transformable stores it, wrapped to [0, 360)
+inline float wrapDegrees(float angle) {
+    return sf::degrees(angle).wrapUnsigned().asDegrees();
+}
+
+// Cheaper wrap for an angle that left [0, 360) by less than a full turn, as it does after
+// one tick of rotation. Matches the SIMD kernel in AsteroidPool bit for bit.
+inline float wrapAngle(float angle) {
+    if (angle >= 360.0f) angle -= 360.0f;
+    if (angle < 0.0f) angle += 360.0f;
+    return angle;
+}
+
+enum class AsteroidSize { Small, Medium, Large };
+
+class Asteroid {
+private:
+    sf::Vector2f position;
+    sf::Vector2f velocity;
+    float rotation = 0.0f;
+    float rotationSpeed;    // degrees per second
+    sf::Vector2f size;
+    float x_scale, y_scale;
+    bool collided;
+    AsteroidSize kind;
+
+public:
+    Asteroid(AsteroidSize kind, sf::Vector2f textureSize, float x_scale, float y_scale)
+        : size(textureSize), x_scale(x_scale), y_scale(y_scale), collided(false), kind(kind) {
+        rotationSpeed = 0.0f;
+    }
+
+    sf::Vector2f getPosition() const { return position; }
+    float getRotation() const { return rotation; }
+    sf::Vector2f getVelocity() const { return velocity; }
+    float getRotationSpeed() const { return rotationSpeed; }
+    float getScaleX() const { return x_scale; }
+    float getScaleY() const { return y_scale; }
+    AsteroidSize getKind() const { return kind; }
+
+    void resetCollisionFlag() { collided = false; }
+    void setCollided() { collided = true; }
+    bool hasCollided() const { return collided; }
+
+    void setVelocity(sf::Vector2f velocity) { this->velocity = velocity; }
+    void setPosition(sf::Vector2f position) { this->position = position; }
+
+    // Picks an edge to enter from and a heading towards the middle of the screen from spawn,
+    // and the speed and spin from physics. `speedScale` is the wave director's speed-up.
+    void appear(Random& spawn, Random& physics, unsigned windowWidth, unsigned windowHeight, float speedScale = 1.0f) {
+        int side = spawn.range(0, 3);
+        float spawnX = 0, spawnY = 0;
+        float centerX = windowWidth / 2.0f;
+        float centerY = windowHeight / 2.0f;
+
+        float offsetX = static_cast<float>(spawn.range(-100, 200));
+        float offsetY = static_cast<float>(spawn.range(-100, 200));
+
+        float targetX = centerX + offsetX;
+        float targetY = centerY + offsetY;
+
+        switch (side) {
+        case 0: spawnX = 0; spawnY = static_cast<float>(spawn.below(windowHeight)); break;
+        case 1: spawnX = windowWidth; spawnY = static_cast<float>(spawn.below(windowHeight)); break;
+        case 2: spawnX = static_cast<float>(spawn.below(windowWidth)); spawnY = 0; break;
+        case 3: spawnX = static_cast<float>(spawn.below(windowWidth)); spawnY = windowHeight; break;
+        }
+        position = { spawnX, spawnY };
+
+        float deltaX = targetX - spawnX;
+        float deltaY = targetY - spawnY;
+        float distance = std::sqrt(deltaX * deltaX + deltaY * deltaY);
+
+        // Asteroids used to be moved twice per tick; the doubled speed that gave is what the game
+        // was tuned with, so it's kept here now that they move once
+        float speedMultiplier = 3.0f;
+
+        if (distance != 0) {
+            float baseSpeed = physics.uniform(48.0f, 78.0f);  // pixels per second
+            velocity.x = (deltaX / distance) * baseSpeed * speedMultiplier * speedScale;
+            velocity.y = (deltaY / distance) * baseSpeed * speedMultiplier * speedScale;
+        }
+
+        rotationSpeed = physics.range(1, 5) * 120.0f * (physics.coin() ? 1 : -1);
+    }
+
+    // Starts this asteroid as a piece of one that was just shot: where the parent was, turned
+    // `turn` degrees off its heading and faster, with a spin of its own from physics
+    void breakOff(sf::Vector2f parentPosition, sf::Vector2f parentVelocity, float parentRotation, float turn, Random& physics) {
+        float radian = turn * 3.14159f / 180.0f;
+        float cosine = std::cos(radian);
+        float sine = std::sin(radian);
+        velocity = sf::Vector2f(parentVelocity.x * cosine - parentVelocity.y * sine,
+                                parentVelocity.x * sine + parentVelocity.y * cosine) * FRAGMENT_SPEEDUP;
+        position = parentPosition;
+        rotation = parentRotation;
+        rotationSpeed = physics.range(1, 5) * 120.0f * (physics.coin() ? 1 : -1);
+    }
+
+    void update(float dt) {
+        position += velocity * dt;
+        rotation = wrapAngle(rotation + rotationSpeed * dt);
+    }
+
+    sf::FloatRect getBounds() const { return computeBounds(position, size, { x_scale, y_scale }, rotation); }
+
+    bool isOutOfScreen(float windowWidth, float windowHeight, float margin = 50.0f) const {
+        return position.x < -margin || position.x > windowWidth + margin ||
+            position.y < -margin || position.y > windowHeight + margin;
+    }
+};
+
+class Bullet {
+private:
+    sf::Vector2f position;
+    sf::Vector2f previousPosition;
+    sf::Vector2f velocity;
+    float rotation;
+    sf::Vector2f size;
+    float speed = BULLET_SPEED; // Speed of the bullet
+    float timeLeft = BULLET_LIFETIME;
+    bool active = true;
+
+public:
+    Bullet(sf::Vector2f textureSize, sf::Vector2f position, float angle)
+        : position(position), previousPosition(position), rotation(wrapDegrees(angle)), size(textureSize) {
+        // Convert angle to radians
+        float radian = (angle - 90) * 3.14159f / 180.0f; // SFML rotates clockwise, but we need a top-down angle
+
+        velocity.x = std::cos(radian) * speed;
+        velocity.y = std::sin(radian) * speed;
+    }
+
+    void update(float dt) {
+        previousPosition = position;
+        if (active) {
+            position += velocity * dt;
+            timeLeft -= dt;
+            if (timeLeft <= 0.0f) {
+                active = false; // Expired
+            }
+        }
+    }
+
+    sf::Vector2f getPosition() const { return position; }
+    sf::Vector2f getPreviousPosition() const { return previousPosition; }
+    float getRotation() const { return rotation; }
+
+    bool isOutOfScreen(float windowWidth, float windowHeight, float margin = 10.0f) const {
+        return position.x < -margin || position.x > windowWidth + margin ||
+            position.y < -margin || position.y > windowHeight + margin;
+    }
+
+    bool isActive() const { return active; }
+    void deactivate() { active = false; }
+    sf::FloatRect getBounds() const { return computeBounds(position, size, { 1.0f, 1.0f }, rotation); }
+};
+
+class Spaceship {
+protected:
+    float orientation;
+    float rotation;
+    float previousRotation;
+    sf::Vector2f position;
+    sf::Vector2f previousPosition;
+    sf::Vector2f velocity;
+    sf::Vector2f size;
+    sf::Vector2f scale = { 4, 6 };
+    bool collide = true;
+    float invulnerableTime = 0.0f;
+    unsigned int lives = MAX_LIVES;
+
+public:
+    explicit Spaceship(sf::Vector2f textureSize) : size(textureSize) {
+        position = { width / 2.0f, height / 2.0f };
+        previousPosition = position;
+        orientation = 90.0f;
+        rotation = wrapDegrees(orientation);
+        previousRotation = rotation;
+    }
+
+    void handleKBInput(const InputFrame& input, float dt) {
+        // Handle acceleration based on WASD keys
+        if (input.up) {
+            velocity.y -= ACCELERATION * dt;
+        }
+        if (input.down) {
+            velocity.y += ACCELERATION * dt;
+        }
+        if (input.left) {
+            velocity.x -= ACCELERATION * dt;
+        }
+        if (input.right) {
+            velocity.x += ACCELERATION * dt;
+        }
+
+        // Apply drag
+        float drag = DRAG * dt;
+        if (velocity.x > 0) {
+            velocity.x -= drag;
+            if (velocity.x < 0) velocity.x = 0;
+        }
+        if (velocity.x < 0) {
+            velocity.x += drag;
+            if (velocity.x > 0) velocity.x = 0;
+        }
+        if (velocity.y > 0) {
+            velocity.y -= drag;
+            if (velocity.y < 0) velocity.y = 0;
+        }
+        if (velocity.y < 0) {
+            velocity.y += drag;
+            if (velocity.y > 0) velocity.y = 0;
+        }
+
+        // Limit speed
+        if (std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y) > MAX_SPEED) {
+            float angle = std::atan2(velocity.y, velocity.x);
+            velocity.x = std::cos(angle) * MAX_SPEED;
+            velocity.y = std::sin(angle) * MAX_SPEED;
+        }
+    }
+
+    void reset() {
+        // Reset position and rotation
+        position = { width / 2.0f, height / 2.0f };
+        previousPosition = position;
+        orientation = 90.0f;
+        rotation = wrapDegrees(orientation);
+        previousRotation = rotation;
+
+        // Reset movement
+        velocity = { 0.f, 0.f };
+
+        // Reset lives
+        lives = MAX_LIVES;
+
+        // Reset collision state
+        collide = true;
+        invulnerableTime = 0.0f;
+    }
+
+    void handleMouseInput(sf::Vector2f mousePos) {
+        // Calculate the angle between the spaceship and the mouse cursor
+        float deltaX = mousePos.x - position.x;
+        float deltaY = mousePos.y - position.y;
+        orientation = (std::atan2(deltaY, deltaX) * 180.0f / 3.14159f) + 90.f;
+    }
+
+    void update(float dt) {
+        previousPosition = position;
+        previousRotation = rotation;
+
+        position += velocity * dt;  // Apply movement (WASD)
+        rotation = wrapDegrees(orientation);  // Rotate towards the mouse
+
+        // Check if spaceship goes out of bounds and teleport to the opposite side
+        if (position.x < 0) {
+            position.x = static_cast<float>(width);  // Teleport to the right side
+        }
+        else if (position.x > static_cast<float>(width)) {
+            position.x = 0;  // Teleport to the left side
+        }
+
+        if (position.y < 0) {
+            position.y = static_cast<float>(height);  // Teleport to the bottom
+        }
+        else if (position.y > static_cast<float>(height)) {
+            position.y = 0;  // Teleport to the top
+        }
+
+        if (!collide) {
+            invulnerableTime -= dt;
+            if (invulnerableTime <= 0.0f) {
+                collide = true;
+            }
+        }
+    }
+
+    float getOrientation() const { return orientation; }
+    float getRotation() const { return rotation; }
+    sf::Vector2f getPosition() const { return position; }
+    sf::Vector2f getPreviousPosition() const { return previousPosition; }
+    float getPreviousRotation() const { return previousRotation; }
+    sf::Vector2f getVelocity() const { return velocity; }
+    sf::Vector2f getScale() const { return scale; }
+    sf::FloatRect getBounds() const { return computeBounds(position, size, scale, rotation); }
+
+    void setLives(int x) {
+        lives = x;
+    }
+
+    void Collision() {
+        if (collide) {
+            collide = false; // Disable collision
+            invulnerableTime = INVULNERABLE_TIME; // Start cooldown
+        }
+
+        if (lives > 0) {
+            lives--; // Reduce lives on collision
+        }
+    }
+
+    unsigned int getLives() const { return lives; }
+    bool canCollide() const { return collide; }
+};
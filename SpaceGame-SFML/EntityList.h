@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Dead flags for a container that removes entities once per tick. Entities are killed while
+// the tick runs (indices stay valid), then compact() squeezes the survivors down in one
+// linear pass, keeping their order so later ticks resolve collisions the same way.
+// Shared by EntityList and AsteroidPool.
+class KillList {
+private:
+    std::vector<std::uint8_t> dead;
+    std::size_t deadCount = 0;
+
+public:
+    // Grows the list to `size` entities; new ones are alive. Empty it with clear().
+    void resize(std::size_t size) { dead.resize(size, 0); }
+    void reserve(std::size_t size) { dead.reserve(size); }
+
+    // Forgets every entity, killed ones included
+    void clear() {
+        dead.clear();
+        deadCount = 0;
+    }
+
+    void kill(std::size_t i) {
+        if (!dead[i]) {
+            dead[i] = 1;
+            deadCount++;
+        }
+    }
+
+    bool isDead(std::size_t i) const { return dead[i] != 0; }
+    std::size_t getDeadCount() const { return deadCount; }
+
+    // Calls move(to, from) for every survivor that has to shift down and returns how many
+    // survived. The flags are cleared and resized to the survivor count.
+    template <typename Move>
+    std::size_t compact(Move move) {
+        std::size_t size = dead.size();
+        if (deadCount == 0) return size;
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (dead[i]) continue;
+            if (kept != i) move(kept, i);
+            kept++;
+        }
+
+        dead.assign(kept, 0);
+        deadCount = 0;
+        return kept;
+    }
+};
+
+// Vector of entities with deferred removal; see KillList. Used for bullets; explosions and
+// hearts are in AnimationPool. A list built with a capacity allocates its storage once and
+// reuses the slots of removed entities, so it never touches the heap afterwards; add() fails
+// when it is full.
+template <typename T>
+class EntityList {
+private:
+    std::vector<T> items;
+    KillList killList;
+    std::size_t capacity = 0;       // 0 grows as needed
+    std::size_t highWaterMark = 0;
+
+public:
+    EntityList() = default;
+
+    explicit EntityList(std::size_t capacity) : capacity(capacity) {
+        reserve(capacity);
+    }
+
+    // Returns the new entity, or nullptr when a fixed-capacity list is full
+    template <typename... Args>
+    T* add(Args&&... args) {
+        if (capacity != 0 && items.size() >= capacity) return nullptr;
+
+        items.emplace_back(std::forward<Args>(args)...);
+        killList.resize(items.size());
+        highWaterMark = std::max(highWaterMark, items.size());
+        return &items.back();
+    }
+
+    void kill(std::size_t i) { killList.kill(i); }
+    bool isAlive(std::size_t i) const { return !killList.isDead(i); }
+
+    // Removes the killed entities
+    void compact() {
+        std::size_t kept = killList.compact([this](std::size_t to, std::size_t from) {
+            items[to] = std::move(items[from]);
+        });
+        items.erase(items.begin() + kept, items.end());
+    }
+
+    void clear() {
+        items.clear();
+        killList.clear();
+    }
+
+    void reserve(std::size_t count) {
+        items.reserve(count);
+        killList.reserve(count);
+    }
+
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    std::size_t getCapacity() const { return capacity; }
+
+    // Most slots ever in use at once, killed-but-not-compacted ones included
+    std::size_t getHighWaterMark() const { return highWaterMark; }
+
+    T& operator[](std::size_t i) { return items[i]; }
+    const T& operator[](std::size_t i) const { return items[i]; }
+
+    // Iteration visits killed entities too until the next compact()
+    typename std::vector<T>::iterator begin() { return items.begin(); }
+    typename std::vector<T>::iterator end() { return items.end(); }
+    typename std::vector<T>::const_iterator begin() const { return items.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items.end(); }
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+// Playfield size, shared by the window, the HUD and the simulation
+inline const unsigned int width = 800;
+inline const unsigned int height = 800;
+
+// Gameplay tuning in seconds and pixels per second, so it plays the same at any tick rate.
+// The values were first tuned per frame at 60 frames per second.
+const float BULLET_COOLDONW = 5.0f / 60.0f;
+const float BULLET_SPEED = 600.0f;
+const float BULLET_LIFETIME = 2.0f; // Long enough to cross the playfield diagonally
+const float INVULNERABLE_TIME = 2.0f;
+const unsigned int MAX_LIVES = 5;
+
+// A shot large or medium asteroid breaks into FRAGMENT_COUNT of the next size down. They fly
+// apart up to FRAGMENT_SPREAD degrees off its heading, FRAGMENT_SPEEDUP times as fast.
+const int FRAGMENT_COUNT = 2;
+const float FRAGMENT_SPREAD = 40.0f;
+const float FRAGMENT_SPEEDUP = 1.25f;
+
+const float ACCELERATION = 720.0f;
+const float DRAG = 72.0f;
+const float MAX_SPEED = 360.0f;
+
+// Ticks per second of the simulation; the renderer interpolates between ticks
+const int DEFAULT_TICK_RATE = 60;
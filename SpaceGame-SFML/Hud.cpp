@@ -0,0 +1,54 @@
+#include "Hud.h"
+#include <algorithm>
+#include <cstdio>
+#include "GameConstants.h"
+
+Hud::Hud(const sf::Font& font, const sf::Texture& texture, sf::IntRect lifeRect)
+    : timerText(font), texture(texture), lifeRect(lifeRect) {
+    timerText.setCharacterSize(48);
+    timerText.setFillColor(sf::Color(200, 211, 253));
+    timerText.setString("00:00");
+    timerText.setOrigin(timerText.getLocalBounds().getCenter());
+    timerText.setPosition({ width / 2.0f, 55 });
+    shownSeconds = 0;
+
+    buildHearts(MAX_LIVES);
+}
+
+void Hud::setTimer(int seconds) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%02d:%02d", seconds / 60, seconds % 60);
+    timerText.setString(text);
+    shownSeconds = seconds;
+    counters.timerRebuilds++;
+}
+
+void Hud::buildHearts(unsigned int count) {
+    hearts.clear();
+    for (unsigned int i = 0; i < count; ++i) {
+        // Offset each life icon
+        hearts.add(lifeRect, { 20.0f + (i * 40.0f), height - 50.0f }, { 5, 5 }, { 3.0f, 3.0f });
+    }
+    heartCapacity = count;
+    counters.livesBuilds++;
+}
+
+void Hud::update(float elapsedSeconds, unsigned int lives) {
+    counters.frames++;
+
+    int seconds = static_cast<int>(std::max(elapsedSeconds, 0.0f));
+    if (seconds != shownSeconds) {
+        setTimer(seconds);
+    }
+
+    // Only more lives than were ever built needs new quads
+    if (lives > heartCapacity) {
+        buildHearts(lives);
+    }
+    this->lives = lives;
+}
+
+void Hud::draw(sf::RenderTarget& target) const {
+    target.draw(timerText);
+    hearts.draw(target, texture, lives);
+}
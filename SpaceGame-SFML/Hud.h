@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <cstdint>
+#include "SpriteBatch.h"
+
+// How much work the HUD did, to check that frames where nothing on it changed cost nothing
+struct HudCounters {
+    std::uint64_t frames = 0;           // update() calls
+    std::uint64_t timerRebuilds = 0;    // times the timer text was formatted and set
+    std::uint64_t livesBuilds = 0;      // times the heart quads were (re)built
+};
+
+// The in-game timer and the row of hearts, kept between frames. The timer text is only
+// formatted and handed to sf::Text (which rebuilds its glyph geometry) when the whole second
+// it shows changes, and the heart quads are built once for the most lives the ship can have;
+// a frame draws as many of them as there are lives left.
+class Hud {
+private:
+    sf::Text timerText;
+    int shownSeconds = -1;
+
+    const sf::Texture& texture;
+    sf::IntRect lifeRect;
+    SpriteBatch hearts;
+    unsigned int heartCapacity = 0;
+    unsigned int lives = 0;
+
+    HudCounters counters;
+
+    void setTimer(int seconds);
+    void buildHearts(unsigned int count);
+
+public:
+    // `texture` and `lifeRect` are where the life icon is, usually in the WorldRenderer atlas
+    Hud(const sf::Font& font, const sf::Texture& texture, sf::IntRect lifeRect);
+
+    // Time played in seconds and lives left; cheap when neither changed what is shown
+    void update(float elapsedSeconds, unsigned int lives);
+
+    void draw(sf::RenderTarget& target) const;
+
+    const HudCounters& getCounters() const { return counters; }
+};
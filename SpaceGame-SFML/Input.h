@@ -0,0 +1,84 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Everything the player can do in one tick. The game fills it from the keyboard and mouse,
+// headless runs fill it from a script.
+struct InputFrame {
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+    sf::Vector2f aim;   // cursor position in window coordinates
+    bool fire = false;
+};
+
+// Text input script for headless runs. One line per change of input, held until the next line:
+//
+//     # tick  keys  aimX  aimY  fire
+//     0       WD    400   100   1
+//     120     -     600   400   0
+//
+// `keys` is any combination of W, A, S and D, or '-' for none.
+class InputScript {
+private:
+    struct Entry {
+        unsigned long long tick;
+        InputFrame input;
+    };
+    std::vector<Entry> entries;
+
+public:
+    [[nodiscard]] bool loadFromFile(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        entries.clear();
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream stream(line);
+            Entry entry;
+            std::string keys;
+            int fire = 0;
+            if (!(stream >> entry.tick >> keys >> entry.input.aim.x >> entry.input.aim.y >> fire)) {
+                return false;
+            }
+
+            for (char key : keys) {
+                switch (key) {
+                case 'W': case 'w': entry.input.up = true; break;
+                case 'S': case 's': entry.input.down = true; break;
+                case 'A': case 'a': entry.input.left = true; break;
+                case 'D': case 'd': entry.input.right = true; break;
+                default: break;
+                }
+            }
+            entry.input.fire = fire != 0;
+
+            if (!entries.empty() && entry.tick < entries.back().tick) {
+                return false;   // Ticks must be in order
+            }
+            entries.push_back(entry);
+        }
+        return true;
+    }
+
+    // Input held at the given tick
+    InputFrame at(unsigned long long tick) const {
+        auto it = std::upper_bound(entries.begin(), entries.end(), tick,
+            [](unsigned long long value, const Entry& entry) { return value < entry.tick; });
+        return it == entries.begin() ? InputFrame() : std::prev(it)->input;
+    }
+
+    bool empty() const { return entries.empty(); }
+};
@@ -0,0 +1,174 @@
+#include "InputRecording.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace {
+    const char MAGIC[4] = { 'S', 'G', 'I', 'R' };
+    const std::uint16_t VERSION = 1;
+
+    enum Buttons : std::uint8_t { Up = 1, Down = 2, Left = 4, Right = 8, Fire = 16 };
+
+    bool sameInput(const InputFrame& a, const InputFrame& b) {
+        return a.up == b.up && a.down == b.down && a.left == b.left && a.right == b.right &&
+            a.fire == b.fire && a.aim == b.aim;
+    }
+
+    void writeInteger(std::ofstream& file, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void writeVarint(std::ofstream& file, std::uint64_t value) {
+        while (value >= 0x80) {
+            file.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        file.put(static_cast<char>(value));
+    }
+
+    void writeFloat(std::ofstream& file, float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeInteger(file, bits, 4);
+    }
+
+    bool readInteger(std::ifstream& file, std::uint64_t& value, int bytes) {
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            int byte = file.get();
+            if (byte == std::char_traits<char>::eof()) return false;
+            value |= static_cast<std::uint64_t>(byte) << (8 * i);
+        }
+        return true;
+    }
+
+    bool readVarint(std::ifstream& file, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = file.get();
+            if (byte == std::char_traits<char>::eof()) return false;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    bool readFloat(std::ifstream& file, float& value) {
+        std::uint64_t bits;
+        if (!readInteger(file, bits, 4)) return false;
+        std::uint32_t bits32 = static_cast<std::uint32_t>(bits);
+        std::memcpy(&value, &bits32, sizeof(value));
+        return true;
+    }
+}
+
+void InputRecording::start(std::uint64_t seed, int tickRate) {
+    entries.clear();
+    this->seed = seed;
+    this->tickRate = tickRate;
+    tickCount = 0;
+    finalHash = 0;
+}
+
+void InputRecording::record(const InputFrame& input) {
+    if (entries.empty() || !sameInput(entries.back().input, input)) {
+        entries.push_back({ tickCount, input });
+    }
+    tickCount++;
+}
+
+bool InputRecording::saveToFile(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeInteger(file, VERSION, 2);
+    writeInteger(file, static_cast<std::uint64_t>(tickRate), 2);
+    writeInteger(file, seed, 8);
+    writeInteger(file, tickCount, 8);
+    writeInteger(file, finalHash, 8);
+    writeInteger(file, entries.size(), 4);
+
+    std::uint64_t previousTick = 0;
+    for (const Entry& entry : entries) {
+        writeVarint(file, entry.tick - previousTick);
+        previousTick = entry.tick;
+
+        const InputFrame& input = entry.input;
+        std::uint8_t buttons = (input.up ? Up : 0) | (input.down ? Down : 0) | (input.left ? Left : 0) |
+            (input.right ? Right : 0) | (input.fire ? Fire : 0);
+        file.put(static_cast<char>(buttons));
+        writeFloat(file, input.aim.x);
+        writeFloat(file, input.aim.y);
+    }
+    return static_cast<bool>(file);
+}
+
+bool InputRecording::loadFromFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint64_t version, rate, loadedSeed, loadedTickCount, loadedHash, count;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readInteger(file, version, 2) || version != VERSION ||
+        !readInteger(file, rate, 2) || rate == 0 || !readInteger(file, loadedSeed, 8) ||
+        !readInteger(file, loadedTickCount, 8) || !readInteger(file, loadedHash, 8) ||
+        !readInteger(file, count, 4)) {
+        return false;
+    }
+
+    // An entry takes at least ENTRY_BYTES, so a count the rest of the file can't hold is a
+    // corrupt or truncated recording; reserving it as is could ask for gigabytes
+    const std::uint64_t ENTRY_BYTES = 10;
+    std::streampos entriesStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::uint64_t remaining = static_cast<std::uint64_t>(file.tellg() - entriesStart);
+    file.seekg(entriesStart);
+    if (!file || count > remaining / ENTRY_BYTES) {
+        return false;
+    }
+
+    // Parsed on the side, so a file that fails halfway leaves this recording as it was
+    std::vector<Entry> loaded;
+    loaded.reserve(static_cast<std::size_t>(count));
+    std::uint64_t tick = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::uint64_t delta, buttons;
+        Entry entry;
+        if (!readVarint(file, delta) || !readInteger(file, buttons, 1) ||
+            !readFloat(file, entry.input.aim.x) || !readFloat(file, entry.input.aim.y)) {
+            return false;
+        }
+
+        tick += delta;
+        entry.tick = tick;
+        entry.input.up = (buttons & Up) != 0;
+        entry.input.down = (buttons & Down) != 0;
+        entry.input.left = (buttons & Left) != 0;
+        entry.input.right = (buttons & Right) != 0;
+        entry.input.fire = (buttons & Fire) != 0;
+        loaded.push_back(entry);
+    }
+
+    entries = std::move(loaded);
+    seed = loadedSeed;
+    tickRate = static_cast<int>(rate);
+    tickCount = loadedTickCount;
+    finalHash = loadedHash;
+    return true;
+}
+
+InputFrame InputRecording::at(std::uint64_t tick) const {
+    auto it = std::upper_bound(entries.begin(), entries.end(), tick,
+        [](std::uint64_t value, const Entry& entry) { return value < entry.tick; });
+    return it == entries.begin() ? InputFrame() : std::prev(it)->input;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include "Input.h"
+
+// Per-tick input of a whole session in a compact binary file, for replaying it headless as a
+// load profile or desync check. Together with the seed and tick rate in the header the input
+// is all a World needs to reproduce the run, and the final state hash is stored to compare to.
+//
+// Layout, little-endian:
+//
+//     "SGIR"  u16 version  u16 tickRate  u64 seed  u64 tickCount  u64 finalHash  u32 entryCount
+//     entryCount x { varint ticksSincePrevious  u8 buttons  f32 aimX  f32 aimY }
+//
+// Like InputScript an entry is only written when the input changes, so held keys cost nothing.
+// The aim is kept as the exact cursor position rather than an angle, since the ship turns
+// towards it from wherever it is on that tick.
+//
+// The waves file the session was played with is not part of the recording: replay it with the
+// same --waves, or it desyncs as soon as the difficulty curves differ.
+class InputRecording {
+private:
+    struct Entry {
+        std::uint64_t tick;
+        InputFrame input;
+    };
+    std::vector<Entry> entries;
+
+    std::uint64_t seed = 0;
+    int tickRate = 0;
+    std::uint64_t tickCount = 0;
+    std::uint64_t finalHash = 0;
+
+public:
+    // Drops any recorded input and starts a session with the given world settings
+    void start(std::uint64_t seed, int tickRate);
+
+    // Appends the input of the next tick
+    void record(const InputFrame& input);
+
+    // Closes the session with the hash of the world after its last tick
+    void finish(std::uint64_t finalHash) { this->finalHash = finalHash; }
+
+    [[nodiscard]] bool saveToFile(const std::filesystem::path& path) const;
+    [[nodiscard]] bool loadFromFile(const std::filesystem::path& path);
+
+    // Input held at the given tick
+    InputFrame at(std::uint64_t tick) const;
+
+    std::uint64_t getSeed() const { return seed; }
+    int getTickRate() const { return tickRate; }
+    std::uint64_t getTickCount() const { return tickCount; }
+    std::uint64_t getFinalHash() const { return finalHash; }
+    std::size_t getEntryCount() const { return entries.size(); }
+};
@@ -0,0 +1,108 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, static_cast<std::size_t>(i));
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+bool JobSystem::runOne(std::size_t self) {
+    Chunk chunk;
+    bool found = false;
+
+    // Own work first, newest end
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            found = true;
+        }
+    }
+
+    // Then steal the oldest chunk of the next thread that has any
+    for (std::size_t offset = 1; !found && offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) return false;
+
+    (*chunk.body)(chunk.begin, chunk.end);
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::workerLoop(std::size_t self) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        while (runOne(self)) {
+        }
+    }
+}
+
+void JobSystem::run(std::size_t count, std::size_t chunkSize, const Body& body) {
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    remaining.store(chunkCount, std::memory_order_relaxed);
+
+    // Deal out contiguous runs of chunks, so each thread starts on its own stretch of memory
+    std::size_t threads = queues.size();
+    for (std::size_t t = 0; t < threads; ++t) {
+        std::size_t first = chunkCount * t / threads;
+        std::size_t last = chunkCount * (t + 1) / threads;
+
+        Queue& queue = *queues[t];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (std::size_t c = last; c-- > first; ) {
+            // Reversed, so popping from the back runs the stretch front to back
+            std::size_t begin = c * chunkSize;
+            queue.chunks.push_back({ &body, begin, std::min(begin + chunkSize, count) });
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    // Help until every chunk has finished, including the ones other threads are still running
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        if (!runOne(0)) {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fork-join job system for data-parallel loops. parallelFor() cuts an index range into
+// chunks and deals them out to one deque per thread; every thread works from the back of its
+// own deque and steals from the front of the others' when it runs dry. The calling thread
+// takes part and returns once every chunk has run.
+//
+// Chunks must only write to their own part of the data. Which thread runs a chunk isn't
+// deterministic, so anything order-dependent is written per index or per chunk and merged by
+// the caller in index order afterwards; that way results don't depend on the thread count.
+// parallelFor() must be called from one thread at a time.
+class JobSystem {
+private:
+    using Body = std::function<void(std::size_t, std::size_t)>;
+
+    struct Chunk {
+        const Body* body;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;     // queues[0] belongs to the calling thread
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::uint64_t generation = 0;   // bumped for every batch of chunks
+    bool stopping = false;
+
+    std::atomic<std::size_t> remaining{ 0 };
+
+    bool runOne(std::size_t self);
+    void workerLoop(std::size_t self);
+    void run(std::size_t count, std::size_t chunkSize, const Body& body);
+
+public:
+    // Threads in total, counting the caller; 0 uses every hardware thread
+    explicit JobSystem(unsigned threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(queues.size()); }
+
+    // Calls body(begin, end) for consecutive chunks of at most chunkSize covering [0, count)
+    template <typename Function>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Function&& body) {
+        if (count == 0) return;
+        if (queues.size() == 1 || count <= chunkSize) {
+            body(std::size_t(0), count);
+            return;
+        }
+        run(count, chunkSize, Body(std::forward<Function>(body)));
+    }
+};
+
+// parallelFor on a job system if there is one, or inline on the calling thread if not
+template <typename Function>
+void parallelFor(JobSystem* jobs, std::size_t count, std::size_t chunkSize, Function&& body) {
+    if (jobs) {
+        jobs->parallelFor(count, chunkSize, std::forward<Function>(body));
+    }
+    else if (count > 0) {
+        body(std::size_t(0), count);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// A whole file mapped read-only into memory. The OS pages it in on first touch and shares it
+// with its file cache, so reading from it costs no copy and no read() calls. The data stays
+// valid until the MappedFile is closed or destroyed.
+class MappedFile {
+private:
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int file = -1;
+#endif
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] bool open(const std::filesystem::path& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const std::uint8_t* getData() const { return data; }
+    std::size_t getSize() const { return size; }
+};
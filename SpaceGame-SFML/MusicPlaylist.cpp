@@ -0,0 +1,44 @@
+#include "MusicPlaylist.h"
+
+MusicPlaylist::MusicPlaylist(TrackSource& source, std::size_t firstTrack)
+    : source(source), track(firstTrack) {
+    chunk.resize(CHUNK_FRAMES * source.getChannelCount());
+}
+
+bool MusicPlaylist::openFrom(std::size_t first) {
+    std::size_t count = source.getTrackCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t candidate = (first + i) % count;
+        if (source.openTrack(candidate)) {
+            track = candidate;
+            trackStarts++;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t MusicPlaylist::fill(const std::int16_t*& samples) {
+    samples = chunk.data();
+    if (source.getTrackCount() == 0) return 0;
+    if (!playing) {
+        playing = openFrom(track);
+        if (!playing) return 0;
+    }
+
+    std::size_t filled = 0;
+    std::size_t emptyTracks = 0;    // so a list of empty tracks can't spin forever
+    while (filled < chunk.size()) {
+        std::size_t read = source.read(chunk.data() + filled, chunk.size() - filled);
+        filled += read;
+        if (filled == chunk.size()) break;
+
+        // The track ended inside this chunk; carry on with the next one
+        emptyTracks = read == 0 ? emptyTracks + 1 : 0;
+        if (emptyTracks > source.getTrackCount() || !openFrom((track + 1) % source.getTrackCount())) {
+            playing = false;
+            break;
+        }
+    }
+    return filled;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Where a MusicPlaylist gets its samples from: a list of tracks that can each be started
+// from their first sample and read front to back. Kept free of SFML's audio module so the
+// playlist can run headless against made-up tracks.
+class TrackSource {
+public:
+    virtual ~TrackSource() = default;
+
+    virtual std::size_t getTrackCount() const = 0;
+    virtual unsigned int getChannelCount() const = 0;
+    virtual unsigned int getSampleRate() const = 0;
+
+    // Moves to the first sample of `track`; false if it can't be opened
+    virtual bool openTrack(std::size_t track) = 0;
+
+    // Reads up to `count` interleaved samples of the open track. Fewer means the track ended;
+    // reads never run on into the next track.
+    virtual std::size_t read(std::int16_t* samples, std::size_t count) = 0;
+};
+
+// Plays the tracks of a TrackSource one after another, wrapping around after the last one,
+// in chunks of a fixed size. A chunk that reaches the end of a track is topped up from the
+// start of the next, so there is never a gap between songs, and the only buffer is the one
+// chunk, so memory stays the same however long the tracks are.
+class MusicPlaylist {
+public:
+    static const std::size_t CHUNK_FRAMES = 8192;   // ~0.19 s at 44.1 kHz
+
+private:
+    TrackSource& source;
+    std::vector<std::int16_t> chunk;
+    std::size_t track;
+    bool playing = false;
+    std::uint64_t trackStarts = 0;
+
+    // Opens `track`, or the ones after it if it fails; false if none of them opens
+    bool openFrom(std::size_t first);
+
+public:
+    MusicPlaylist(TrackSource& source, std::size_t firstTrack);
+
+    // Fills the next chunk and points `samples` at it. Returns the number of samples, which is
+    // only short of a full chunk (or 0) if no track can be played.
+    std::size_t fill(const std::int16_t*& samples);
+
+    // Starts the current track again from its first sample on the next fill()
+    void restartTrack() { playing = false; }
+
+    std::size_t getCurrentTrack() const { return track; }
+    std::uint64_t getTrackStarts() const { return trackStarts; }
+    std::size_t getBufferBytes() const { return chunk.capacity() * sizeof(std::int16_t); }
+};
+
+// Stands in for the sound card: pulls chunks from a playlist the way the audio thread would,
+// without playing them. Used to check playback headless.
+class NullAudioDevice {
+private:
+    MusicPlaylist& playlist;
+    std::uint64_t samples = 0;
+    std::uint64_t chunks = 0;
+
+public:
+    explicit NullAudioDevice(MusicPlaylist& playlist) : playlist(playlist) {}
+
+    // Pulls one chunk and hands each sample to `consume`; false once the playlist runs dry
+    template <typename Consumer>
+    bool pull(Consumer&& consume) {
+        const std::int16_t* data = nullptr;
+        std::size_t count = playlist.fill(data);
+        for (std::size_t i = 0; i < count; ++i) {
+            consume(data[i]);
+        }
+        samples += count;
+        chunks++;
+        return count > 0;
+    }
+
+    std::uint64_t getSampleCount() const { return samples; }
+    std::uint64_t getChunkCount() const { return chunks; }
+};
@@ -0,0 +1,185 @@
+#include "MusicStream.h"
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "Random.h"
+
+namespace {
+    // Where each song of bg.ogg starts, in seconds; a song ends where the next one starts
+    const float SONG_STARTS[] = {
+        0,      // Nebula Purple
+        239,    // Martian Red
+        461,    // Gamma Ray Yellow
+        572,    // Plasma Blue
+        811,    // Cosmic Dust Brown
+        920,    // Pulsar Green
+        1160,   // Quantum Indigo
+        1390,   // Asteroid Grey
+        1625,   // Quasar Gold
+        1800,   // Nebula Purple II
+        2039,   // Martian Red II
+        2261,   // Gamma Ray Yellow II
+        2372,   // Plasma Blue II
+        2611,   // Cosmic Dust Brown II
+        2720,   // Pulsar Green II
+        2960,   // Quantum Indigo II
+        3190,   // Asteroid Grey II
+        3425    // Quasar Gold II
+    };
+    const std::size_t SONG_COUNT = sizeof(SONG_STARTS) / sizeof(SONG_STARTS[0]);
+
+    std::filesystem::path trackPath(const std::filesystem::path& directory, std::size_t track) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "track%02u.ogg", static_cast<unsigned>(track));
+        return directory / name;
+    }
+
+    // Song boundaries in samples of an open soundtrack, ending with its total sample count
+    std::vector<std::uint64_t> indexSongs(const sf::InputSoundFile& file) {
+        std::vector<std::uint64_t> starts;
+        for (float start : SONG_STARTS) {
+            std::uint64_t frame = static_cast<std::uint64_t>(std::llround(start * file.getSampleRate()));
+            starts.push_back(std::min(frame * file.getChannelCount(), file.getSampleCount()));
+        }
+        starts.push_back(file.getSampleCount());
+        return starts;
+    }
+}
+
+const char* MusicStream::SOUNDTRACK_PATH = "Audio/bg.ogg";
+const char* MusicStream::TRACKS_DIRECTORY = "Audio/Tracks";
+
+bool SoundtrackSource::openTracks(const std::filesystem::path& directory) {
+    trackPaths.clear();
+    trackStarts.clear();
+    for (std::size_t track = 0; track < SONG_COUNT; ++track) {
+        std::filesystem::path path = trackPath(directory, track);
+        if (!std::filesystem::exists(path)) {
+            trackPaths.clear();
+            return false;
+        }
+        trackPaths.push_back(path);
+    }
+
+    // All songs were written in the format of the first one
+    if (!file.openFromFile(trackPaths[0])) {
+        trackPaths.clear();
+        return false;
+    }
+    channelCount = file.getChannelCount();
+    sampleRate = file.getSampleRate();
+    channelMap = file.getChannelMap();
+    return true;
+}
+
+bool SoundtrackSource::openSoundtrack(const std::filesystem::path& path) {
+    trackPaths.clear();
+    if (!file.openFromFile(path)) return false;
+
+    channelCount = file.getChannelCount();
+    sampleRate = file.getSampleRate();
+    channelMap = file.getChannelMap();
+    trackStarts = indexSongs(file);
+    position = 0;
+    return true;
+}
+
+std::size_t SoundtrackSource::getTrackCount() const {
+    return isSplit() ? trackPaths.size() : (trackStarts.empty() ? 0 : trackStarts.size() - 1);
+}
+
+bool SoundtrackSource::openTrack(std::size_t track) {
+    if (track >= getTrackCount()) return false;
+
+    if (isSplit()) {
+        if (!file.openFromFile(trackPaths[track])) {
+            std::cerr << "ERROR: COULD NOT LOAD MUSIC: " << trackPaths[track].string() << "!\n";
+            return false;
+        }
+        if (file.getChannelCount() != channelCount || file.getSampleRate() != sampleRate) {
+            std::cerr << "ERROR: MUSIC TRACK HAS A DIFFERENT FORMAT: " << trackPaths[track].string() << "!\n";
+            return false;
+        }
+        position = 0;
+        end = file.getSampleCount();
+        return true;
+    }
+
+    // Playing on into the next song needs no seek
+    if (position != trackStarts[track]) {
+        file.seek(trackStarts[track]);
+        position = trackStarts[track];
+        seeks++;
+    }
+    end = trackStarts[track + 1];
+    return true;
+}
+
+std::size_t SoundtrackSource::read(std::int16_t* samples, std::size_t count) {
+    std::uint64_t wanted = std::min<std::uint64_t>(count, end - position);
+    if (wanted == 0) return 0;
+
+    std::uint64_t read = file.read(samples, wanted);
+    position += read;
+    if (read < wanted) end = position;  // The file is shorter than the index says
+    return static_cast<std::size_t>(read);
+}
+
+bool SoundtrackSource::splitSoundtrack(const std::filesystem::path& soundtrack, const std::filesystem::path& directory) {
+    sf::InputSoundFile input;
+    if (!input.openFromFile(soundtrack)) {
+        std::cerr << "ERROR: COULD NOT LOAD MUSIC: " << soundtrack.string() << "!\n";
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    std::vector<std::uint64_t> starts = indexSongs(input);
+    std::vector<std::int16_t> buffer(MusicPlaylist::CHUNK_FRAMES * input.getChannelCount());
+    for (std::size_t track = 0; track < SONG_COUNT; ++track) {
+        std::filesystem::path path = trackPath(directory, track);
+        sf::OutputSoundFile output;
+        if (!output.openFromFile(path, input.getSampleRate(), input.getChannelCount(), input.getChannelMap())) {
+            std::cerr << "ERROR: COULD NOT SAVE MUSIC: " << path.string() << "!\n";
+            return false;
+        }
+
+        // Songs are read back to back, so the soundtrack is decoded once without seeking
+        std::uint64_t remaining = starts[track + 1] - starts[track];
+        while (remaining > 0) {
+            std::uint64_t read = input.read(buffer.data(), std::min<std::uint64_t>(buffer.size(), remaining));
+            if (read == 0) break;
+            output.write(buffer.data(), read);
+            remaining -= read;
+        }
+    }
+    return true;
+}
+
+bool MusicStream::open(std::uint64_t seed) {
+    if (!source.openTracks(TRACKS_DIRECTORY) && !source.openSoundtrack(SOUNDTRACK_PATH)) {
+        return false;
+    }
+
+    // individual song randomizer
+    Random songRandom = makeRandom(seed, RandomStream::Audio);
+    std::size_t first = songRandom.below(static_cast<std::uint32_t>(source.getTrackCount()));
+    playlist = std::make_unique<MusicPlaylist>(source, first);
+
+    initialize(source.getChannelCount(), source.getSampleRate(), source.getChannelMap());
+    return true;
+}
+
+bool MusicStream::onGetData(Chunk& data) {
+    data.sampleCount = playlist->fill(data.samples);
+    return data.sampleCount > 0;
+}
+
+void MusicStream::onSeek(sf::Time) {
+    // Only stop() seeks (back to the start); pick up from the start of the current song
+    playlist->restartTrack();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/SoundChannel.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "MusicPlaylist.h"
+
+// The songs of the soundtrack as a TrackSource. It reads either one file per song, split out
+// of bg.ogg by `SpaceGame-SFML --split-music`, or bg.ogg itself with an index of where each
+// song starts. One file per song starts every song from its first sample without seeking.
+// With the single file only the first song needs a seek: songs after it follow on from where
+// the previous one stopped, and the index keeps each read inside its song.
+class SoundtrackSource : public TrackSource {
+private:
+    sf::InputSoundFile file;
+    std::vector<std::filesystem::path> trackPaths;  // one file per song, if split
+    std::vector<std::uint64_t> trackStarts;         // in samples, plus the end; single file only
+    std::vector<sf::SoundChannel> channelMap;
+    unsigned int channelCount = 0;
+    unsigned int sampleRate = 0;
+
+    std::uint64_t position = 0;     // next sample the file will read
+    std::uint64_t end = 0;          // end of the open song
+    std::uint64_t seeks = 0;
+
+public:
+    // Uses the songs split into `directory`; false unless all of them are there
+    [[nodiscard]] bool openTracks(const std::filesystem::path& directory);
+
+    // Uses the whole soundtrack file, indexed by the song start times
+    [[nodiscard]] bool openSoundtrack(const std::filesystem::path& path);
+
+    std::size_t getTrackCount() const override;
+    unsigned int getChannelCount() const override { return channelCount; }
+    unsigned int getSampleRate() const override { return sampleRate; }
+    const std::vector<sf::SoundChannel>& getChannelMap() const { return channelMap; }
+
+    bool openTrack(std::size_t track) override;
+    std::size_t read(std::int16_t* samples, std::size_t count) override;
+
+    bool isSplit() const { return !trackPaths.empty(); }
+
+    // Seeks done inside the soundtrack file so far
+    std::uint64_t getSeekCount() const { return seeks; }
+
+    // Writes every song of the soundtrack to its own file in `directory`
+    [[nodiscard]] static bool splitSoundtrack(const std::filesystem::path& soundtrack, const std::filesystem::path& directory);
+};
+
+// Background music: the soundtrack streamed through a MusicPlaylist, starting at a song picked
+// from the seed and running on from song to song without gaps. Decoding happens a chunk at a
+// time on SFML's streaming thread, so only a few chunks are ever held in memory.
+class MusicStream : public sf::SoundStream {
+public:
+    static const char* SOUNDTRACK_PATH;
+    static const char* TRACKS_DIRECTORY;
+
+private:
+    SoundtrackSource source;
+    std::unique_ptr<MusicPlaylist> playlist;
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+public:
+    // Opens the split songs if they've been built, otherwise the soundtrack file
+    [[nodiscard]] bool open(std::uint64_t seed);
+
+    // True if the songs come from their own files rather than the indexed soundtrack
+    bool isSplit() const { return source.isSplit(); }
+};
@@ -0,0 +1,155 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLE_KERNEL_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_KERNEL_SSE2
+#endif
+
+ParticleSystem::ParticleSystem(std::size_t capacity, std::uint64_t seed)
+    : x(capacity), y(capacity), vx(capacity), vy(capacity), life(capacity), inverseLifetime(capacity),
+      damping(capacity), radius(capacity), spec(capacity), capacity(capacity), random(makeRandom(seed, RandomStream::Effects)) {
+}
+
+std::uint8_t ParticleSystem::specIndex(const ParticleSpec& particles) {
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+        if (specs[i] == &particles) return static_cast<std::uint8_t>(i);
+    }
+    specs.push_back(&particles);
+    return static_cast<std::uint8_t>(specs.size() - 1);
+}
+
+void ParticleSystem::emit(const ParticleSpec& particles, sf::Vector2f position, float heading, float spread) {
+    if (count >= capacity) {
+        dropped++;
+        return;
+    }
+
+    float radian = (heading + random.uniform(-spread, spread)) * 3.14159f / 180.0f;
+    float speed = random.uniform(particles.minSpeed, particles.maxSpeed);
+    float lifetime = random.uniform(particles.minLife, particles.maxLife);
+
+    std::size_t i = count++;
+    x[i] = position.x;
+    y[i] = position.y;
+    vx[i] = std::cos(radian) * speed;
+    vy[i] = std::sin(radian) * speed;
+    life[i] = lifetime;
+    inverseLifetime[i] = 1.0f / lifetime;
+    damping[i] = -std::log(particles.drag);
+    radius[i] = particles.size * random.uniform(0.6f, 1.0f);
+    spec[i] = specIndex(particles);
+}
+
+void ParticleSystem::burst(const ParticleSpec& particles, sf::Vector2f position, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        emit(particles, position, 0.0f, 180.0f);
+    }
+}
+
+void ParticleSystem::spray(const ParticleSpec& particles, sf::Vector2f position, float heading, float spread, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        emit(particles, position, heading, spread);
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    std::size_t i = 0;
+    float* px = x.data();
+    float* py = y.data();
+    float* pvx = vx.data();
+    float* pvy = vy.data();
+    float* pl = life.data();
+    const float* pd = damping.data();
+
+    // Drag as 1 - rate * dt per update, close to drag^dt at frame-sized steps and cheap to
+    // vectorize; clamped so a long frame stops a particle instead of reversing it
+#if defined(PARTICLE_KERNEL_AVX)
+    const __m256 step = _mm256_set1_ps(dt);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m256 keep = _mm256_max_ps(zero, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(pd + i), step)));
+        __m256 velocityX = _mm256_mul_ps(_mm256_loadu_ps(pvx + i), keep);
+        __m256 velocityY = _mm256_mul_ps(_mm256_loadu_ps(pvy + i), keep);
+        _mm256_storeu_ps(pvx + i, velocityX);
+        _mm256_storeu_ps(pvy + i, velocityY);
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), _mm256_mul_ps(velocityX, step)));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), _mm256_mul_ps(velocityY, step)));
+        _mm256_storeu_ps(pl + i, _mm256_sub_ps(_mm256_loadu_ps(pl + i), step));
+    }
+#elif defined(PARTICLE_KERNEL_SSE2)
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 keep = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(pd + i), step)));
+        __m128 velocityX = _mm_mul_ps(_mm_loadu_ps(pvx + i), keep);
+        __m128 velocityY = _mm_mul_ps(_mm_loadu_ps(pvy + i), keep);
+        _mm_storeu_ps(pvx + i, velocityX);
+        _mm_storeu_ps(pvy + i, velocityY);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(velocityX, step)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velocityY, step)));
+        _mm_storeu_ps(pl + i, _mm_sub_ps(_mm_loadu_ps(pl + i), step));
+    }
+#endif
+
+    // Scalar tail, or the whole range without SIMD
+    for (; i < count; ++i) {
+        float keep = std::max(0.0f, 1.0f - pd[i] * dt);
+        pvx[i] *= keep;
+        pvy[i] *= keep;
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+        pl[i] -= dt;
+    }
+
+    // Order doesn't matter for drawing, so a dead particle just takes the last one's place
+    for (std::size_t j = 0; j < count;) {
+        if (life[j] > 0.0f) {
+            ++j;
+            continue;
+        }
+        std::size_t last = --count;
+        x[j] = x[last];
+        y[j] = y[last];
+        vx[j] = vx[last];
+        vy[j] = vy[last];
+        life[j] = life[last];
+        inverseLifetime[j] = inverseLifetime[last];
+        damping[j] = damping[last];
+        radius[j] = radius[last];
+        spec[j] = spec[last];
+    }
+}
+
+void ParticleSystem::fill(std::vector<sf::Vertex>& vertices) const {
+    vertices.resize(count * 3);
+    sf::Vertex* out = vertices.data();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const ParticleSpec& particles = *specs[spec[i]];
+
+        // Fade in 1/256 steps with integer blends; 256 at birth, 0 at death
+        int t = static_cast<int>(life[i] * inverseLifetime[i] * 256.0f);
+        t = t > 256 ? 256 : t;
+        const sf::Color& start = particles.startColor;
+        const sf::Color& end = particles.endColor;
+        sf::Color color(
+            static_cast<std::uint8_t>(end.r + (((start.r - end.r) * t) >> 8)),
+            static_cast<std::uint8_t>(end.g + (((start.g - end.g) * t) >> 8)),
+            static_cast<std::uint8_t>(end.b + (((start.b - end.b) * t) >> 8)),
+            static_cast<std::uint8_t>((255 * t) >> 8));
+
+        // A small triangle around the particle, tip up
+        float s = radius[i];
+        out[0] = { { x[i], y[i] - s }, color, {} };
+        out[1] = { { x[i] + 0.87f * s, y[i] + 0.5f * s }, color, {} };
+        out[2] = { { x[i] - 0.87f * s, y[i] + 0.5f * s }, color, {} };
+        out += 3;
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Random.h"
+
+// How a group of particles looks and moves when emitted
+struct ParticleSpec {
+    float minSpeed, maxSpeed;   // pixels per second
+    float minLife, maxLife;     // seconds
+    float size;                 // pixels from the centre to the tips
+    float drag;                 // fraction of the speed kept after one second
+    sf::Color startColor;       // at birth; fades to endColor and transparent by the end of its life
+    sf::Color endColor;
+};
+
+const ParticleSpec DEBRIS_PARTICLES = { 60.0f, 260.0f, 0.4f, 1.1f, 2.5f, 0.15f, { 255, 230, 150 }, { 200, 60, 20 } };
+const ParticleSpec THRUSTER_PARTICLES = { 30.0f, 90.0f, 0.2f, 0.45f, 1.5f, 0.3f, { 170, 220, 255 }, { 40, 70, 200 } };
+
+// Cosmetic particles (explosion debris, engine trails) in structure-of-arrays storage. Movement,
+// drag and ageing run as one vectorized pass over the x/y/vx/vy/life arrays (AVX or SSE2 when
+// the compiler targets them, scalar otherwise), and every live particle becomes one triangle in
+// a vertex array the renderer uploads to a single vertex buffer. Nothing here touches the GPU,
+// so the update and the vertex fill can be timed headless.
+//
+// Particles don't affect gameplay and aren't part of the World or its state hash; they run on
+// their own random stream. Storage is allocated once; emitting beyond the capacity drops the
+// extra particles and counts them.
+class ParticleSystem {
+private:
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> life;            // seconds left
+    std::vector<float> inverseLifetime; // 1 / seconds it was born with, to fade by
+    std::vector<float> damping;         // -ln(drag): speed lost per second, as a rate
+    std::vector<float> radius;          // pixels from the centre to the tips
+    std::vector<std::uint8_t> spec;     // index into specs
+    std::vector<const ParticleSpec*> specs;
+    std::size_t count = 0;
+    std::size_t capacity;
+    std::uint64_t dropped = 0;
+    Random random;
+
+    std::uint8_t specIndex(const ParticleSpec& particles);
+    void emit(const ParticleSpec& particles, sf::Vector2f position, float heading, float spread);
+
+public:
+    explicit ParticleSystem(std::size_t capacity, std::uint64_t seed = 1);
+
+    // `count` particles flying out from `position` in every direction
+    void burst(const ParticleSpec& particles, sf::Vector2f position, std::size_t count);
+
+    // `count` particles from `position` heading `heading` degrees (0 along +x, clockwise like
+    // SFML), up to `spread` degrees off it either way
+    void spray(const ParticleSpec& particles, sf::Vector2f position, float heading, float spread, std::size_t count);
+
+    // Moves, slows and ages every particle by dt seconds, then removes the ones that ran out
+    void update(float dt);
+
+    // Writes one triangle per live particle into `vertices`, which is resized to 3 * size()
+    void fill(std::vector<sf::Vertex>& vertices) const;
+
+    void clear() { count = 0; }
+
+    std::size_t size() const { return count; }
+    std::size_t getCapacity() const { return capacity; }
+
+    // Particles left out because the system was full
+    std::uint64_t getDroppedCount() const { return dropped; }
+};
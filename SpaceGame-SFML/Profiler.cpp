@@ -0,0 +1,103 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "SystemTimings.h"
+
+namespace {
+    float toMicros(Profiler::Clock::duration time) {
+        return std::chrono::duration<float, std::micro>(time).count();
+    }
+}
+
+Profiler::Profiler(std::size_t history) : frames(std::max<std::size_t>(history, 1)) {
+    for (int i = 0; i < static_cast<int>(System::Count); ++i) {
+        zoneNames.push_back(getSystemName(static_cast<System>(i)));
+    }
+}
+
+int Profiler::addZone(const char* name) {
+    if (zoneNames.size() >= MAX_ZONES) return static_cast<int>(MAX_ZONES) - 1;
+    zoneNames.push_back(name);
+    return static_cast<int>(zoneNames.size()) - 1;
+}
+
+void Profiler::beginFrame() {
+    current = Frame();
+    frameStart = Clock::now();
+}
+
+void Profiler::addTime(int zone, Clock::duration time) {
+    current.zoneMicros[zone] += toMicros(time);
+}
+
+void Profiler::endFrame(const FrameCounts& counts) {
+    current.frameMicros = toMicros(Clock::now() - frameStart);
+    current.counts = counts;
+    frames[next] = current;
+    next = (next + 1) % frames.size();
+    recorded++;
+}
+
+std::size_t Profiler::getFrameCount() const {
+    return static_cast<std::size_t>(std::min<std::uint64_t>(recorded, frames.size()));
+}
+
+double Profiler::getFramePercentile(double percentile) const {
+    std::size_t count = getFrameCount();
+    if (count == 0) return 0.0;
+
+    std::vector<float> times(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        times[i] = frames[i].frameMicros;
+    }
+
+    // Nearest rank
+    std::size_t rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * count));
+    rank = std::min(std::max<std::size_t>(rank, 1), count) - 1;
+    std::nth_element(times.begin(), times.begin() + rank, times.end());
+    return times[rank] / 1000.0;
+}
+
+double Profiler::getZoneAverage(int zone) const {
+    std::size_t count = getFrameCount();
+    if (count == 0) return 0.0;
+
+    double total = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total += frames[i].zoneMicros[zone];
+    }
+    return total / count / 1000.0;
+}
+
+const FrameCounts& Profiler::getLastCounts() const {
+    return frames[(next + frames.size() - 1) % frames.size()].counts;
+}
+
+bool Profiler::writeCsv(const std::filesystem::path& path) const {
+    std::FILE* file = std::fopen(path.string().c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "frame,frame_ms");
+    for (const char* name : zoneNames) {
+        std::fprintf(file, ",%s_ms", name);
+    }
+    std::fprintf(file, ",asteroids,bullets,effects\n");
+
+    std::size_t count = getFrameCount();
+    std::size_t oldest = count < frames.size() ? 0 : next;
+    std::uint64_t firstFrame = recorded - count;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Frame& frame = frames[(oldest + i) % frames.size()];
+        std::fprintf(file, "%llu,%.4f", static_cast<unsigned long long>(firstFrame + i), frame.frameMicros / 1000.0);
+        for (std::size_t zone = 0; zone < zoneNames.size(); ++zone) {
+            std::fprintf(file, ",%.4f", frame.zoneMicros[zone] / 1000.0);
+        }
+        std::fprintf(file, ",%zu,%zu,%zu\n", frame.counts.asteroids, frame.counts.bullets, frame.counts.effects);
+    }
+
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
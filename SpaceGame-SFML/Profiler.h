@@ -0,0 +1,87 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// Entity counts stored with every profiled frame
+struct FrameCounts {
+    std::size_t asteroids = 0;
+    std::size_t bullets = 0;
+    std::size_t effects = 0;
+};
+
+// Per-frame zone profiler. Code marks zones with ProfileZone; the time of every zone is summed
+// over the frame and kept, with the frame time and entity counts, in a ring buffer of the last
+// frames. The ring can be summarised as percentiles or written out as CSV.
+//
+// Zone ids 0 to System::Count - 1 are the simulation systems (see SystemTimings.h), registered
+// by the constructor; other zones are added with addZone() before the first frame.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static const std::size_t MAX_ZONES = 16;
+
+private:
+    struct Frame {
+        float frameMicros = 0.0f;
+        float zoneMicros[MAX_ZONES] = {};
+        FrameCounts counts;
+    };
+
+    std::vector<const char*> zoneNames;
+    std::vector<Frame> frames;      // ring buffer
+    std::size_t next = 0;           // slot of the frame being recorded
+    std::uint64_t recorded = 0;     // frames finished since construction
+    Frame current;
+    Clock::time_point frameStart;
+
+public:
+    explicit Profiler(std::size_t history = 600);
+
+    // Returns the id to pass to ProfileZone. Names must outlive the profiler.
+    int addZone(const char* name);
+
+    void beginFrame();
+    void addTime(int zone, Clock::duration time);
+    void endFrame(const FrameCounts& counts);
+
+    // Frames kept in the ring, at most the history size
+    std::size_t getFrameCount() const;
+    std::uint64_t getRecordedFrames() const { return recorded; }
+
+    // Frame time in milliseconds at the given percentile (0-100) of the kept frames
+    double getFramePercentile(double percentile) const;
+
+    // Average milliseconds per frame spent in a zone over the kept frames
+    double getZoneAverage(int zone) const;
+
+    std::size_t getZoneCount() const { return zoneNames.size(); }
+    const char* getZoneName(int zone) const { return zoneNames[zone]; }
+    const FrameCounts& getLastCounts() const;
+
+    // One row per kept frame: frame number, frame time and zone times in ms, entity counts
+    [[nodiscard]] bool writeCsv(const std::filesystem::path& path) const;
+};
+
+// Adds the time between construction and destruction to a zone of the profiler. A null
+// profiler makes it do nothing, so zones can stay in code that runs unprofiled.
+class ProfileZone {
+private:
+    Profiler* profiler;
+    int zone;
+    Profiler::Clock::time_point start;
+
+public:
+    ProfileZone(Profiler* profiler, int zone) : profiler(profiler), zone(zone) {
+        if (profiler) start = Profiler::Clock::now();
+    }
+
+    ~ProfileZone() {
+        if (profiler) profiler->addTime(zone, Profiler::Clock::now() - start);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+
+// Seedable PCG32 generator (permuted congruential, 64-bit state, 32-bit output). Every system
+// that needs randomness owns one, created from the run seed and its own stream number, so the
+// sequences are independent: spawning an extra asteroid never changes which song plays, and
+// a run started from the same seed replays bit for bit.
+class Random {
+private:
+    std::uint64_t state = 0;
+    std::uint64_t increment = 1;
+
+public:
+    explicit Random(std::uint64_t seed = 1, std::uint64_t stream = 0) {
+        // Same seeding as the reference pcg32_srandom_r; the increment picks the stream
+        increment = (stream << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    std::uint32_t next() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ull + increment;
+        std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        std::uint32_t rot = static_cast<std::uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // Uniform in [0, bound) without the bias of next() % bound (Lemire's multiply-and-reject)
+    std::uint32_t below(std::uint32_t bound) {
+        std::uint64_t product = static_cast<std::uint64_t>(next()) * bound;
+        std::uint32_t low = static_cast<std::uint32_t>(product);
+        if (low < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>(next()) * bound;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32u);
+    }
+
+    // Uniform integer in [min, max]
+    int range(int min, int max) {
+        return min + static_cast<int>(below(static_cast<std::uint32_t>(max - min) + 1u));
+    }
+
+    // Uniform in [0, 1), from the top 24 bits so every value is exact in a float
+    float uniform() {
+        return (next() >> 8u) * (1.0f / 16777216.0f);
+    }
+
+    float uniform(float min, float max) {
+        return min + (max - min) * uniform();
+    }
+
+    bool coin() { return (next() >> 31u) != 0; }
+};
+
+// Stream numbers of the independent sequences drawn from one run seed
+enum class RandomStream : std::uint64_t {
+    Spawn = 1,      // where asteroids enter and what they aim at
+    Physics = 2,    // asteroid speed and spin
+    Audio = 3,      // song picker
+    Bench = 4,      // SpaceGame-Headless micro-benchmarks
+    Effects = 5     // particles; cosmetic, never part of the simulation
+};
+
+inline Random makeRandom(std::uint64_t seed, RandomStream stream) {
+    return Random(seed, static_cast<std::uint64_t>(stream));
+}
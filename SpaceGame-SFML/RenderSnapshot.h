@@ -0,0 +1,45 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Everything WorldRenderer needs to draw one tick, copied out of the World. A snapshot owns
+// its data, so a render thread can draw it while the simulation thread moves on. Poses hold
+// the previous and current tick so the drawing can be interpolated between them.
+struct RenderSnapshot {
+    struct Pose {
+        sf::Vector2f previousPosition;
+        sf::Vector2f position;
+        float previousRotation = 0.0f;
+        float rotation = 0.0f;
+    };
+
+    struct AsteroidSprite {
+        Pose pose;
+        sf::Vector2f scale;
+        std::uint8_t kind = 0;     // AsteroidSize
+    };
+
+    // Frame sizes are in the AnimationSpec of each list
+    struct AnimationFrame {
+        sf::Vector2f position;
+        std::uint32_t startTick = 0;    // low 32 bits, so the renderer can tell new ones apart
+        std::uint8_t frame = 0;
+    };
+
+    std::uint64_t tick = 0;
+    float tickSeconds = 0.0f;
+    std::chrono::steady_clock::time_point publishedAt;
+
+    Pose ship;
+    sf::Vector2f shipScale;
+    sf::Vector2f shipVelocity;
+    bool shipVulnerable = true;
+    unsigned int lives = 0;
+
+    std::vector<AsteroidSprite> asteroids;
+    std::vector<Pose> bullets;
+    std::vector<AnimationFrame> explosions;
+    std::vector<AnimationFrame> hearts;
+};
@@ -0,0 +1,84 @@
+#include "SimulationThread.h"
+#include <chrono>
+
+SimulationThread::SimulationThread(World& world, InputSource input, Options options)
+    : world(world), input(std::move(input)), options(options) {
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (thread.joinable()) return;
+
+    stopping = false;
+    finished = false;
+    publish();  // The renderer has something to draw before the first tick
+    thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    stopping = true;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool SimulationThread::resume(std::uint64_t deathsSeen) {
+    std::lock_guard<std::mutex> lock(pauseMutex);
+    if (deaths != deathsSeen) return false;
+    paused = false;
+    return true;
+}
+
+void SimulationThread::publish() {
+    RenderSnapshot& snapshot = snapshots.getBack();
+    world.capture(snapshot);
+    snapshot.publishedAt = std::chrono::steady_clock::now();
+    snapshots.publish();
+}
+
+void SimulationThread::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto tickLength = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(world.getTickSeconds()));
+    const auto MAX_LAG = std::chrono::milliseconds(250);   // Don't try to catch up after a long stall
+
+    Clock::time_point nextTick = Clock::now();
+    while (!stopping) {
+        if (paused) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            nextTick = Clock::now();
+            continue;
+        }
+
+        if (options.realTime) {
+            Clock::time_point now = Clock::now();
+            if (now < nextTick) {
+                std::this_thread::sleep_until(nextTick);
+                continue;
+            }
+            if (now - nextTick > MAX_LAG) {
+                nextTick = now;
+            }
+            nextTick += tickLength;
+        }
+
+        world.step(input(ticks));
+        ticks++;
+
+        if (world.isShipDestroyed()) {
+            world.reset();
+            std::lock_guard<std::mutex> lock(pauseMutex);
+            deaths++;
+            if (options.pauseOnDeath) paused = true;
+        }
+
+        publish();
+
+        if (options.tickLimit != 0 && ticks >= options.tickLimit) {
+            finished = true;
+            return;
+        }
+    }
+}
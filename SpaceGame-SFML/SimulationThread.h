@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "Input.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "World.h"
+
+// Steps a World on its own thread and publishes a RenderSnapshot after every tick through a
+// triple buffer, so rendering (and vsync waits) never hold up the simulation and the other way
+// round. While the thread runs it owns the World; other threads only read snapshots.
+//
+// In real time mode ticks are paced by the clock at the world's tick rate, like the game loop.
+// Otherwise it steps as fast as it can, which is what headless runs use.
+class SimulationThread {
+public:
+    // Input for a tick, called on the simulation thread
+    using InputSource = std::function<InputFrame(std::uint64_t tick)>;
+
+    struct Options {
+        bool realTime = true;
+        bool pauseOnDeath = true;       // the game shows its death menu; headless plays on
+        std::uint64_t tickLimit = 0;    // stop after this many ticks; 0 runs until stop()
+    };
+
+private:
+    World& world;
+    InputSource input;
+    Options options;
+
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::thread thread;
+    std::atomic<bool> stopping{ false };
+    std::atomic<bool> paused{ false };
+    std::atomic<bool> finished{ false };
+    std::atomic<std::uint64_t> deaths{ 0 };
+    std::mutex pauseMutex;      // orders resume() against a death pausing the thread
+    std::uint64_t ticks = 0;
+
+    void run();
+    void publish();
+
+public:
+    SimulationThread(World& world, InputSource input, Options options);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+
+    // Joins the thread; the World can be used from the caller again afterwards
+    void stop();
+
+    // A paused simulation keeps its state and doesn't catch up on the time it was paused
+    void pause() { paused = true; }
+    bool isPaused() const { return paused; }
+
+    // Unpauses unless the ship died again since the caller last looked at getDeaths(), so a
+    // death that pauses the thread can't be undone by a resume racing with it
+    bool resume(std::uint64_t deathsSeen);
+
+    // True once the tick limit is reached
+    bool isFinished() const { return finished; }
+
+    // Ship deaths so far; the world is reset right after each one
+    std::uint64_t getDeaths() const { return deaths; }
+
+    // Reader side of the snapshots, for one render thread
+    bool updateSnapshot() { return snapshots.update(); }
+    const RenderSnapshot& getSnapshot() const { return snapshots.getFront(); }
+};
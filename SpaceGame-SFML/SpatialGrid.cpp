@@ -0,0 +1,92 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(sf::FloatRect area, float cellSize)
+    : area(area), cellSize(cellSize),
+      columns(std::max(1, static_cast<int>(std::ceil(area.size.x / cellSize)))),
+      rows(std::max(1, static_cast<int>(std::ceil(area.size.y / cellSize)))) {
+    cellStart.assign(static_cast<std::size_t>(columns) * rows + 1, 0);
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsOf(const sf::FloatRect& box) const {
+    auto column = [this](float x) {
+        return std::clamp(static_cast<int>(std::floor((x - area.position.x) / cellSize)), 0, columns - 1);
+    };
+    auto row = [this](float y) {
+        return std::clamp(static_cast<int>(std::floor((y - area.position.y) / cellSize)), 0, rows - 1);
+    };
+    return { column(box.position.x), row(box.position.y),
+             column(box.position.x + box.size.x), row(box.position.y + box.size.y) };
+}
+
+void SpatialGrid::build(const std::vector<sf::FloatRect>& boxes) {
+    // Counting sort of the entities into their cells: count, prefix sum, then fill
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (const sf::FloatRect& box : boxes) {
+        CellRange cells = cellsOf(box);
+        for (int y = cells.top; y <= cells.bottom; ++y) {
+            for (int x = cells.left; x <= cells.right; ++x) {
+                cellStart[y * columns + x + 1]++;
+            }
+        }
+    }
+    for (std::size_t cell = 1; cell < cellStart.size(); ++cell) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+
+    items.resize(cellStart.back());
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        CellRange cells = cellsOf(boxes[i]);
+        for (int y = cells.top; y <= cells.bottom; ++y) {
+            for (int x = cells.left; x <= cells.right; ++x) {
+                items[cursor[y * columns + x]++] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+
+    lastQuery.assign(boxes.size(), 0);
+    queryStamp = 0;
+}
+
+void SpatialGrid::query(const sf::FloatRect& box, std::vector<std::size_t>& out) {
+    out.clear();
+    if (++queryStamp == 0) {
+        // Stamp wrapped around: forget every previous query
+        std::fill(lastQuery.begin(), lastQuery.end(), 0);
+        queryStamp = 1;
+    }
+
+    CellRange cells = cellsOf(box);
+    for (int y = cells.top; y <= cells.bottom; ++y) {
+        for (int x = cells.left; x <= cells.right; ++x) {
+            int cell = y * columns + x;
+            for (std::uint32_t item = cellStart[cell]; item < cellStart[cell + 1]; ++item) {
+                std::uint32_t index = items[item];
+                if (lastQuery[index] != queryStamp) {
+                    lastQuery[index] = queryStamp;
+                    out.push_back(index);
+                }
+            }
+        }
+    }
+
+    // Entities are resolved in vector order, like the exhaustive loops did
+    std::sort(out.begin(), out.end());
+}
+
+void SpatialGrid::queryShared(const sf::FloatRect& box, std::vector<std::size_t>& out) const {
+    out.clear();
+
+    CellRange cells = cellsOf(box);
+    for (int y = cells.top; y <= cells.bottom; ++y) {
+        for (int x = cells.left; x <= cells.right; ++x) {
+            int cell = y * columns + x;
+            out.insert(out.end(), items.begin() + cellStart[cell], items.begin() + cellStart[cell + 1]);
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
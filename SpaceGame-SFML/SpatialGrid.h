@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid broad phase over the playfield. Rebuilt from scratch every tick from a list of
+// boxes (one per entity, indexed like the entity vector); queries return the indices of the
+// boxes sharing a cell with the query box, which then go through the exact test.
+// Boxes outside the grid area are clamped into the border cells.
+// All storage is reused between rebuilds, so a warmed-up grid doesn't allocate.
+class SpatialGrid {
+private:
+    sf::FloatRect area;
+    float cellSize;
+    int columns;
+    int rows;
+
+    std::vector<std::uint32_t> cellStart;   // columns * rows + 1 offsets into `items`
+    std::vector<std::uint32_t> items;       // entity indices, grouped by cell
+    std::vector<std::uint32_t> cursor;      // fill position per cell while building
+    std::vector<std::uint32_t> lastQuery;   // per entity, last query that returned it
+    std::uint32_t queryStamp = 0;
+
+    struct CellRange {
+        int left, top, right, bottom;
+    };
+    CellRange cellsOf(const sf::FloatRect& box) const;
+
+public:
+    SpatialGrid(sf::FloatRect area, float cellSize);
+
+    void build(const std::vector<sf::FloatRect>& boxes);
+
+    // Replaces `out` with the candidates for `box`, each once and in ascending order
+    void query(const sf::FloatRect& box, std::vector<std::size_t>& out);
+
+    // Same result as query(), but leaves the grid untouched so several threads can query at
+    // once; duplicates are removed by sorting instead of with the per-entity stamps
+    void queryShared(const sf::FloatRect& box, std::vector<std::size_t>& out) const;
+
+    std::size_t getCellCount() const { return static_cast<std::size_t>(columns) * rows; }
+    std::size_t getEntryCount() const { return items.size(); }
+};
@@ -0,0 +1,51 @@
+#include "SpriteBatch.h"
+#include <SFML/Graphics/RenderStates.hpp>
+#include <algorithm>
+#include <cmath>
+
+void SpriteBatch::add(const sf::IntRect& textureRect, sf::Vector2f position, sf::Vector2f origin,
+                      sf::Vector2f scale, float rotation, sf::Color color) {
+    float radian = rotation * 3.14159f / 180.0f;
+    float cosine = std::cos(radian);
+    float sine = std::sin(radian);
+
+    sf::Vector2f size(textureRect.size);
+    sf::Vector2f texture(textureRect.position);
+    const sf::Vector2f corners[4] = { { 0, 0 }, { size.x, 0 }, { size.x, size.y }, { 0, size.y } };
+
+    sf::Vertex quad[4];
+    for (int i = 0; i < 4; ++i) {
+        float localX = (corners[i].x - origin.x) * scale.x;
+        float localY = (corners[i].y - origin.y) * scale.y;
+        quad[i].position = { position.x + localX * cosine - localY * sine, position.y + localX * sine + localY * cosine };
+        quad[i].color = color;
+        quad[i].texCoords = texture + corners[i];
+    }
+
+    // Two triangles per quad
+    vertices.append(quad[0]);
+    vertices.append(quad[1]);
+    vertices.append(quad[2]);
+    vertices.append(quad[0]);
+    vertices.append(quad[2]);
+    vertices.append(quad[3]);
+}
+
+std::size_t SpriteBatch::draw(sf::RenderTarget& target, const sf::Texture& texture) const {
+    if (vertices.getVertexCount() == 0) return 0;
+
+    sf::RenderStates states;
+    states.texture = &texture;
+    target.draw(vertices, states);
+    return 1;
+}
+
+std::size_t SpriteBatch::draw(sf::RenderTarget& target, const sf::Texture& texture, std::size_t spriteCount) const {
+    std::size_t vertexCount = std::min(spriteCount * 6, vertices.getVertexCount());
+    if (vertexCount == 0) return 0;
+
+    sf::RenderStates states;
+    states.texture = &texture;
+    target.draw(&vertices[0], vertexCount, sf::PrimitiveType::Triangles, states);
+    return 1;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <cstddef>
+
+// Collects textured quads from one texture into a single vertex array and draws them with one
+// draw call. The quads are transformed on the CPU the way sf::Sprite would (origin, scale,
+// rotation, position). Cleared and refilled every frame; the vertex storage is reused.
+class SpriteBatch {
+private:
+    sf::VertexArray vertices{ sf::PrimitiveType::Triangles };
+
+public:
+    void clear() { vertices.clear(); }
+
+    void add(const sf::IntRect& textureRect, sf::Vector2f position, sf::Vector2f origin,
+             sf::Vector2f scale = { 1.0f, 1.0f }, float rotation = 0.0f, sf::Color color = sf::Color::White);
+
+    std::size_t getSpriteCount() const { return vertices.getVertexCount() / 6; }
+
+    // Returns the number of draw calls issued: 1, or 0 when the batch is empty
+    std::size_t draw(sf::RenderTarget& target, const sf::Texture& texture) const;
+
+    // Draws only the first `spriteCount` quads, for batches built once and shown in part
+    std::size_t draw(sf::RenderTarget& target, const sf::Texture& texture, std::size_t spriteCount) const;
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+
+// Generated by `SpaceGame-SFML --dump-masks` from the files in Sprites/; don't edit by hand.
+// Size and solid pixels of every sprite the simulation collides, as CollisionMask::fromText()
+// reads them. WorldConfig's defaults come from here, so headless runs get the same collisions
+// as the game without loading any texture. Regenerate after changing a sprite, or recordings
+// of the game won't replay the same headless.
+
+// Spaceship3.png
+const sf::Vector2i SPACESHIP3_SIZE = { 10, 18 };
+const char* const SPACESHIP3_MASK =
+    ".........."
+    "....##...."
+    "...####..."
+    "...####..."
+    "...####..."
+    "...####..."
+    "...####..."
+    "..######.."
+    "..######.."
+    "..######.."
+    ".########."
+    ".########."
+    ".########."
+    "##########"
+    "##########"
+    "##########"
+    ".########."
+    "..........";
+
+// bullet1.png
+const sf::Vector2i BULLET1_SIZE = { 10, 10 };
+const char* const BULLET1_MASK =
+    ".........."
+    ".........."
+    "...####..."
+    "..######.."
+    "..######.."
+    "..######.."
+    "..######.."
+    "...####..."
+    ".........."
+    "..........";
+
+// AsteroidSmall.png
+const sf::Vector2i ASTEROID_SMALL_SIZE = { 10, 18 };
+const char* const ASTEROID_SMALL_MASK =
+    ".........."
+    ".........."
+    ".........."
+    "..####...."
+    "..#####..."
+    "..######.."
+    "..#######."
+    ".########."
+    ".########."
+    ".########."
+    ".#########"
+    ".#########"
+    "...#######"
+    ".......##."
+    ".........."
+    ".........."
+    ".........."
+    "..........";
+
+// AsteroidMedium.png
+const sf::Vector2i ASTEROID_MEDIUM_SIZE = { 20, 20 };
+const char* const ASTEROID_MEDIUM_MASK =
+    "...................."
+    "....###########....."
+    "...#############...."
+    ".###############...."
+    "################...."
+    "##################.."
+    ".#################.."
+    ".##################."
+    "..#################."
+    "..#################."
+    "..#################."
+    "..#################."
+    "..################.."
+    "..################.."
+    "..################.."
+    "....#############..."
+    "......###########..."
+    "................#..."
+    "...................."
+    "....................";
+
+// AsteroidLarge.png
+const sf::Vector2i ASTEROID_LARGE_SIZE = { 30, 30 };
+const char* const ASTEROID_LARGE_MASK =
+    ".............................."
+    ".............................."
+    ".............................."
+    "............##############...."
+    ".......###################...."
+    ".....######################..."
+    "....#######################..."
+    "....#######################..."
+    "...########################..."
+    "...########################..."
+    "..#########################..."
+    "..########################...."
+    "..########################...."
+    "..########################...."
+    "..########################...."
+    "..########################...."
+    "..#########################..."
+    "...########################..."
+    "...########################..."
+    "...########################..."
+    "....#######################..."
+    "....#######################..."
+    "....#######################..."
+    "....######################...."
+    ".....#####################...."
+    "................########......"
+    ".................######......."
+    ".................####........."
+    ".............................."
+    "..............................";
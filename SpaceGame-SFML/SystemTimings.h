@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Profiler.h"
+
+// The stages of a frame, in the order they run. The World runs Input to Cull once per tick;
+// WorldRenderer runs RenderPrep once per drawn frame.
+enum class System { Input, Integrate, BroadPhase, Collisions, Spawn, Cull, RenderPrep, Count };
+
+inline const char* getSystemName(System system) {
+    switch (system) {
+    case System::Input: return "input";
+    case System::Integrate: return "integrate";
+    case System::BroadPhase: return "broad-phase";
+    case System::Collisions: return "collisions";
+    case System::Spawn: return "spawn";
+    case System::Cull: return "cull";
+    case System::RenderPrep: return "render-prep";
+    default: return "?";
+    }
+}
+
+// Accumulated wall time and run count per system, so a run can show where its time goes.
+// With a profiler attached, each run also counts towards the system's zone of the current frame.
+class SystemTimings {
+private:
+    static const std::size_t COUNT = static_cast<std::size_t>(System::Count);
+    std::chrono::steady_clock::duration total[COUNT] = {};
+    std::uint64_t runs[COUNT] = {};
+    Profiler* profiler = nullptr;
+
+public:
+    void attach(Profiler* profiler) { this->profiler = profiler; }
+
+    template <typename Body>
+    void run(System system, Body&& body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto time = std::chrono::steady_clock::now() - start;
+        std::size_t i = static_cast<std::size_t>(system);
+        total[i] += time;
+        runs[i]++;
+        if (profiler) profiler->addTime(static_cast<int>(i), time);
+    }
+
+    double getSeconds(System system) const {
+        return std::chrono::duration<double>(total[static_cast<std::size_t>(system)]).count();
+    }
+
+    std::uint64_t getRuns(System system) const { return runs[static_cast<std::size_t>(system)]; }
+
+    void reset() {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            total[i] = {};
+            runs[i] = 0;
+        }
+    }
+};
@@ -0,0 +1,104 @@
+#include "TextureAtlas.h"
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    const unsigned int PADDING = 1;
+
+    // Shelf packing into a square of `side` pixels; returns false if the images don't fit
+    bool packShelves(const std::vector<sf::Image>& images, const std::vector<std::size_t>& order, unsigned int side,
+              std::vector<sf::Vector2u>& positions) {
+        unsigned int x = 0, y = 0, shelfHeight = 0;
+        for (std::size_t i : order) {
+            sf::Vector2u size = images[i].getSize();
+            if (x + size.x > side) {
+                x = 0;
+                y += shelfHeight + PADDING;
+                shelfHeight = 0;
+            }
+            if (x + size.x > side || y + size.y > side) {
+                return false;
+            }
+
+            positions[i] = { x, y };
+            x += size.x + PADDING;
+            shelfHeight = std::max(shelfHeight, size.y);
+        }
+        return true;
+    }
+}
+
+TextureAtlas::Packed TextureAtlas::pack(const std::vector<std::string>& paths) {
+    std::vector<sf::Image> images(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (!images[i].loadFromFile(paths[i])) {
+            std::cerr << "ERROR: COULD NOT LOAD SPRITE: " << paths[i] << std::endl;
+        }
+    }
+
+    std::vector<std::size_t> order(paths.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&images](std::size_t a, std::size_t b) {
+        return images[a].getSize().y > images[b].getSize().y;
+    });
+
+    std::vector<sf::Vector2u> positions(paths.size());
+    unsigned int side = 64;
+    while (!packShelves(images, order, side, positions)) {
+        side *= 2;
+    }
+
+    Packed packed;
+    sf::Image& atlas = packed.image;
+    atlas.resize({ side, side }, sf::Color::Transparent);
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        sf::Vector2u size = images[i].getSize();
+        if (size.x > 0 && size.y > 0 && !atlas.copy(images[i], positions[i])) {
+            std::cerr << "ERROR: COULD NOT PACK SPRITE: " << paths[i] << std::endl;
+        }
+        packed.regions[paths[i]] = sf::IntRect(sf::Vector2i(positions[i]), sf::Vector2i(size));
+    }
+
+    return packed;
+}
+
+void TextureAtlas::build(TextureCache& cache, const std::vector<std::string>& paths) {
+    upload(cache, pack(paths));
+}
+
+void TextureAtlas::upload(TextureCache& cache, const Packed& packed) {
+    regions = packed.regions;
+    texture = cache.fromImage(AssetPack::ATLAS, packed.image);
+}
+
+bool TextureAtlas::hasAtlas(const AssetPack& pack, const std::vector<std::string>& paths) {
+    const AssetPack::Entry* image = pack.find(AssetPack::ATLAS);
+    if (!image || image->kind != AssetPack::Kind::Image) return false;
+
+    for (const std::string& path : paths) {
+        const AssetPack::Entry* region = pack.find(path);
+        if (!region || region->kind != AssetPack::Kind::Region) return false;
+    }
+    return true;
+}
+
+bool TextureAtlas::load(TextureCache& cache, const AssetPack& pack, const std::vector<std::string>& paths) {
+    if (!hasAtlas(pack, paths)) return false;
+    const AssetPack::Entry* image = pack.find(AssetPack::ATLAS);
+
+    regions.clear();
+    for (const auto& entry : pack.getEntries()) {
+        if (entry.second.kind == AssetPack::Kind::Region) {
+            regions[entry.first] = entry.second.rect;
+        }
+    }
+
+    texture = cache.fromPixels(AssetPack::ATLAS, sf::Vector2u(image->rect.size), image->data);
+    return true;
+}
+
+sf::IntRect TextureAtlas::getRegion(const std::string& path) const {
+    auto it = regions.find(path);
+    return it != regions.end() ? it->second : sf::IntRect();
+}
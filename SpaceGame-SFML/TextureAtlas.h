@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <map>
+#include <string>
+#include <vector>
+#include "AssetPack.h"
+#include "TextureCache.h"
+
+// Packs several sprite sheets into one texture at startup, so everything drawn from them can
+// share a single texture bind. Images are placed on shelves, tallest first, with a pixel of
+// padding between them; the atlas grows in powers of two until they all fit. The packing can
+// also be done offline into an AssetPack, which then only has to be uploaded.
+class TextureAtlas {
+public:
+    // The atlas image and the sprite regions in it, before upload. Packing only touches the CPU,
+    // so it can run on a loader thread.
+    struct Packed {
+        sf::Image image;
+        std::map<std::string, sf::IntRect> regions;
+    };
+
+private:
+    TextureHandle texture;
+    std::map<std::string, sf::IntRect> regions;
+
+public:
+    // Loads and packs the images at `paths`, uploading the result through the cache.
+    // Images that fail to load are logged and get an empty region.
+    void build(TextureCache& cache, const std::vector<std::string>& paths);
+
+    // Uses the atlas packed into an asset pack instead; false if hasAtlas() isn't true of it
+    [[nodiscard]] bool load(TextureCache& cache, const AssetPack& pack, const std::vector<std::string>& paths);
+
+    // True if `pack` has an atlas with a region for every one of `paths`. A pack built before a
+    // sprite was added has no region for it, and would draw that sprite as nothing; it counts
+    // as stale, and the loose files are used instead.
+    static bool hasAtlas(const AssetPack& pack, const std::vector<std::string>& paths);
+
+    // Uploads an atlas packed with pack()
+    void upload(TextureCache& cache, const Packed& packed);
+
+    // Decodes and packs the images at `paths` without uploading anything
+    static Packed pack(const std::vector<std::string>& paths);
+
+    const sf::Texture& getTexture() const { return *texture; }
+
+    // Where the image loaded from `path` ended up, in atlas pixels
+    sf::IntRect getRegion(const std::string& path) const;
+};
@@ -0,0 +1,55 @@
+#include "TextureCache.h"
+#include <iostream>
+
+TextureHandle TextureCache::get(const std::string& path) {
+    std::weak_ptr<const sf::Texture>& entry = textures[path];
+    if (TextureHandle texture = entry.lock()) {
+        return texture;
+    }
+
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        std::cerr << "ERROR: COULD NOT LOAD SPRITE: " << path << std::endl;
+    }
+    else {
+        uploads++;
+    }
+
+    entry = texture;
+    return texture;
+}
+
+TextureHandle TextureCache::fromImage(const std::string& name, const sf::Image& image) {
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(image)) {
+        std::cerr << "ERROR: COULD NOT CREATE TEXTURE: " << name << std::endl;
+    }
+    else {
+        uploads++;
+    }
+
+    textures[name] = texture;
+    return texture;
+}
+
+TextureHandle TextureCache::fromPixels(const std::string& name, sf::Vector2u size, const std::uint8_t* pixels) {
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->resize(size)) {
+        std::cerr << "ERROR: COULD NOT CREATE TEXTURE: " << name << std::endl;
+    }
+    else {
+        texture->update(pixels);
+        uploads++;
+    }
+
+    textures[name] = texture;
+    return texture;
+}
+
+std::size_t TextureCache::getTextureCount() const {
+    std::size_t count = 0;
+    for (const auto& entry : textures) {
+        if (!entry.second.expired()) count++;
+    }
+    return count;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+using TextureHandle = std::shared_ptr<const sf::Texture>;
+
+// Loads every texture once and hands out shared, reference-counted handles to it. A texture
+// lives as long as someone holds a handle; asking for the same path again while it is alive
+// returns the same GPU texture instead of decoding and uploading a copy.
+class TextureCache {
+private:
+    std::map<std::string, std::weak_ptr<const sf::Texture>> textures;
+    std::size_t uploads = 0;
+
+public:
+    // Never returns null: a file that fails to load logs an error and gives an empty texture,
+    // like a failed loadFromFile() always did
+    TextureHandle get(const std::string& path);
+
+    // Uploads an image built at runtime (e.g. an atlas) and caches it under `name`
+    TextureHandle fromImage(const std::string& name, const sf::Image& image);
+
+    // Uploads RGBA pixels that are already decoded, straight from where they are in memory
+    TextureHandle fromPixels(const std::string& name, sf::Vector2u size, const std::uint8_t* pixels);
+
+    // Textures currently alive
+    std::size_t getTextureCount() const;
+
+    // Textures decoded and uploaded to the GPU since the cache was created
+    std::size_t getUploadCount() const { return uploads; }
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer, single-consumer triple buffer. The writer fills its back slot and
+// publishes it by swapping it with the middle one; the reader swaps the middle slot into its
+// front slot when something new was published. Neither side ever waits for the other, and
+// the reader always sees the latest complete value (older ones are dropped, not queued).
+template <typename T>
+class TripleBuffer {
+private:
+    static const std::uint8_t INDEX_MASK = 3;
+    static const std::uint8_t FRESH = 4;    // set on `middle` when it holds an unread value
+
+    T slots[3];
+    std::atomic<std::uint8_t> middle{ 1 };
+    std::uint8_t back = 0;      // writer only
+    std::uint8_t front = 2;     // reader only
+
+public:
+    // Writer: the slot to fill. It holds whatever was in it before, to reuse its storage.
+    T& getBack() { return slots[back]; }
+
+    // Writer: hands the back slot to the reader
+    void publish() {
+        back = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader: moves to the latest published value; false if nothing new arrived
+    bool update() {
+        if ((middle.load(std::memory_order_acquire) & FRESH) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Reader: the value update() last moved to
+    const T& getFront() const { return slots[front]; }
+};
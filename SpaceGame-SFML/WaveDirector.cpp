@@ -0,0 +1,122 @@
+#include "WaveDirector.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+WaveTable::WaveTable() {
+    stages = {
+        { 0.0f,   2.0f, 1.0f,  { 1, 1, 1 } },
+        { 60.0f,  3.0f, 1.1f,  { 1, 1, 1 } },
+        { 180.0f, 5.0f, 1.25f, { 2, 2, 1 } },
+        { 360.0f, 8.0f, 1.4f,  { 1, 2, 2 } },
+    };
+    maxAsteroids = 300;
+    maxSpawnRate = 20.0f;
+    maxSpeed = 2.0f;
+}
+
+bool WaveTable::loadFromFile(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    return file && load(file);
+}
+
+bool WaveTable::load(std::istream& stream) {
+    std::vector<WaveStage> loaded;
+    std::size_t asteroids = maxAsteroids;
+    float rate = maxSpawnRate, speed = maxSpeed;
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first) || first[0] == '#') continue;
+
+        if (first == "limit") {
+            std::string name;
+            float value;
+            if (!(fields >> name >> value) || value < 0) return false;
+            if (name == "asteroids") asteroids = static_cast<std::size_t>(value);
+            else if (name == "rate") rate = value;
+            else if (name == "speed") speed = value;
+            else return false;
+            continue;
+        }
+
+        WaveStage stage;
+        std::istringstream numbers(line);
+        if (!(numbers >> stage.time >> stage.spawnRate >> stage.speed >> stage.mix[0] >> stage.mix[1] >> stage.mix[2])) {
+            return false;
+        }
+        if (stage.spawnRate < 0 || stage.speed <= 0 || stage.mix[0] < 0 || stage.mix[1] < 0 || stage.mix[2] < 0 ||
+            stage.mix[0] + stage.mix[1] + stage.mix[2] <= 0) {
+            return false;
+        }
+        if (!loaded.empty() && stage.time <= loaded.back().time) {
+            return false;   // Stages must be in order
+        }
+        loaded.push_back(stage);
+    }
+    if (loaded.empty()) return false;
+
+    stages = std::move(loaded);
+    maxAsteroids = asteroids;
+    maxSpawnRate = rate;
+    maxSpeed = speed;
+    return true;
+}
+
+WaveStage WaveTable::at(float seconds) const {
+    if (stages.size() == 1 || seconds <= stages.front().time) {
+        return stages.front();
+    }
+
+    // The pair of stages around `seconds`, or the last two to carry on from
+    auto next = std::upper_bound(stages.begin(), stages.end(), seconds,
+        [](float value, const WaveStage& stage) { return value < stage.time; });
+    if (next == stages.end()) --next;
+    const WaveStage& from = *std::prev(next);
+    const WaveStage& to = *next;
+
+    float t = (seconds - from.time) / (to.time - from.time);
+    WaveStage stage = to;
+    stage.time = seconds;
+    stage.spawnRate = std::clamp(from.spawnRate + (to.spawnRate - from.spawnRate) * t, 0.0f, std::max(maxSpawnRate, to.spawnRate));
+    stage.speed = std::clamp(from.speed + (to.speed - from.speed) * t, 0.1f, std::max(maxSpeed, to.speed));
+    if (t < 1.0f) {
+        for (int i = 0; i < 3; ++i) {
+            stage.mix[i] = from.mix[i] + (to.mix[i] - from.mix[i]) * t;
+        }
+    }
+    return stage;
+}
+
+WaveDirector::WaveDirector(const WaveTable& table) : table(&table) {
+    reset();
+}
+
+void WaveDirector::reset() {
+    elapsed = 0.0f;
+    spawnBudget = 0.0f;
+    stage = table->at(0.0f);
+}
+
+std::size_t WaveDirector::update(float dt, std::size_t liveAsteroids) {
+    elapsed += dt;
+    stage = table->at(elapsed);
+
+    spawnBudget += stage.spawnRate * dt;
+    std::size_t count = static_cast<std::size_t>(spawnBudget);
+    spawnBudget -= static_cast<float>(count);
+
+    // At the limit the spawns are skipped rather than saved up for later
+    std::size_t room = table->getMaxAsteroids() > liveAsteroids ? table->getMaxAsteroids() - liveAsteroids : 0;
+    return std::min(count, room);
+}
+
+AsteroidSize WaveDirector::pickSize(Random& random) const {
+    float pick = random.uniform(0.0f, stage.mix[0] + stage.mix[1] + stage.mix[2]);
+    if (pick < stage.mix[0]) return AsteroidSize::Small;
+    if (pick < stage.mix[0] + stage.mix[1]) return AsteroidSize::Medium;
+    return AsteroidSize::Large;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <vector>
+#include "Entities.h"
+#include "Random.h"
+
+// How hard the game is at one moment of play
+struct WaveStage {
+    float time = 0.0f;          // seconds since the game started
+    float spawnRate = 0.0f;     // asteroids per second
+    float speed = 1.0f;         // multiplier on the asteroids' base speed
+    float mix[3] = { 1, 1, 1 }; // relative odds of a small, medium and large asteroid
+};
+
+// The difficulty curve, read from a text file with one stage per line in order of time:
+//
+//     # seconds  spawns/s  speed  small  medium  large
+//     0          2         1.0    1      1       1
+//     120        4         1.3    1      2       2
+//     limit asteroids 400
+//     limit rate 30
+//     limit speed 2.5
+//
+// Values are interpolated between stages. After the last stage the spawn rate and speed keep
+// growing at the pace they had between the last two, up to the limits, so the game never stops
+// getting harder. The size mix stays at the last stage's. `limit asteroids` is the most
+// asteroids alive at once; spawns beyond it are skipped.
+class WaveTable {
+private:
+    std::vector<WaveStage> stages;
+    std::size_t maxAsteroids = 400;
+    float maxSpawnRate = 30.0f;
+    float maxSpeed = 2.5f;
+
+public:
+    // The curve in Waves/default.waves, built in so headless runs play the same game without
+    // the file. Keep the two in step, or game recordings won't replay the same.
+    WaveTable();
+
+    [[nodiscard]] bool loadFromFile(const std::filesystem::path& path);
+    [[nodiscard]] bool load(std::istream& stream);
+
+    // The stage in effect `seconds` into a game
+    WaveStage at(float seconds) const;
+
+    std::size_t getMaxAsteroids() const { return maxAsteroids; }
+    std::size_t getStageCount() const { return stages.size(); }
+};
+
+// Walks a game along a WaveTable: tells the world how many asteroids to spawn each tick, how
+// fast and how big. Spawns accumulate fractionally, so any rate comes out right at any tick rate.
+class WaveDirector {
+private:
+    const WaveTable* table;
+    float elapsed = 0.0f;
+    float spawnBudget = 0.0f;
+    WaveStage stage;
+
+public:
+    explicit WaveDirector(const WaveTable& table);
+
+    // Back to the start of the curve, for a new game
+    void reset();
+
+    // Advances by dt seconds and returns how many asteroids to spawn now, given how many are alive
+    std::size_t update(float dt, std::size_t liveAsteroids);
+
+    // Draws the size of the next asteroid from the current mix
+    AsteroidSize pickSize(Random& random) const;
+
+    float getSpeed() const { return stage.speed; }
+    float getElapsed() const { return elapsed; }
+    const WaveStage& getStage() const { return stage; }
+};
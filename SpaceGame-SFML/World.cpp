@@ -0,0 +1,325 @@
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Cells a bit smaller than a large asteroid's hit box; the area covers the margin asteroids
+    // travel through before they're culled
+    const float GRID_CELL_SIZE = 64.0f;
+    const float GRID_MARGIN = 64.0f;
+
+    // Work per job chunk; small enough to spread a few thousand asteroids over the cores
+    const std::size_t ASTEROID_CHUNK = 1024;
+    const std::size_t BULLET_CHUNK = 16;
+
+    const sf::Vector2f ASTEROID_SCALE = { 3.5f, 4.5f };
+    const sf::Vector2f BULLET_SCALE = { 1.0f, 1.0f };
+
+    // Box around a circle of `radius` moving from `start` to `end`
+    sf::FloatRect sweptBounds(sf::Vector2f start, sf::Vector2f end, float radius) {
+        sf::Vector2f topLeft(std::min(start.x, end.x) - radius, std::min(start.y, end.y) - radius);
+        sf::Vector2f bottomRight(std::max(start.x, end.x) + radius, std::max(start.y, end.y) + radius);
+        return sf::FloatRect(topLeft, bottomRight - topLeft);
+    }
+}
+
+World::World(const WorldConfig& config)
+    : config(config), tickSeconds(1.0f / config.tickRate),
+      spawnRandom(makeRandom(config.seed, RandomStream::Spawn)), physicsRandom(makeRandom(config.seed, RandomStream::Physics)),
+      spaceship(config.shipSize), asteroids(config.asteroidSizes, config.asteroidCapacity), bullets(config.bulletCapacity),
+      explosions(EXPLOSION_ANIMATION, config.explosionCapacity, config.tickRate), hexplosions(HEART_ANIMATION, config.heartCapacity, config.tickRate),
+      director(this->config.waves),
+      shipShape(config.shipMask, spaceship.getScale()), bulletShape(config.bulletMask, BULLET_SCALE),
+      asteroidShapes{ CollisionShape(config.asteroidMasks[0], ASTEROID_SCALE), CollisionShape(config.asteroidMasks[1], ASTEROID_SCALE),
+                      CollisionShape(config.asteroidMasks[2], ASTEROID_SCALE) },
+      asteroidGrid(sf::FloatRect({ -GRID_MARGIN, -GRID_MARGIN }, { width + 2 * GRID_MARGIN, height + 2 * GRID_MARGIN }), GRID_CELL_SIZE) {
+}
+
+void World::updateBroadPhase() {
+    // Bounding circles don't turn with the asteroid, so no transform is computed at all. Each box
+    // covers the circle all along this tick's move, for the swept bullet tests.
+    asteroidBoxes.resize(asteroids.size());
+    parallelFor(jobs, asteroids.size(), ASTEROID_CHUNK, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            float radius = asteroidShapes[static_cast<int>(asteroids.getKind(i))].getRadius();
+            asteroidBoxes[i] = sweptBounds(asteroids.getPreviousPosition(i), asteroids.getPosition(i), radius);
+        }
+    });
+    asteroidGrid.build(asteroidBoxes);
+}
+
+void World::step(const InputFrame& input) {
+    tick++;
+
+    // Each system touches every entity it cares about once, in this order
+    timings.run(System::Input, [&] { applyInput(input); });
+    timings.run(System::Integrate, [&] { integrate(); });
+    timings.run(System::BroadPhase, [&] { updateBroadPhase(); });
+    timings.run(System::Collisions, [&] { resolveCollisions(); });
+    timings.run(System::Spawn, [&] { spawn(input); });
+    timings.run(System::Cull, [&] { cull(); });
+}
+
+void World::applyInput(const InputFrame& input) {
+    spaceship.handleMouseInput(input.aim);
+    spaceship.handleKBInput(input, tickSeconds);
+    bullet_cooldown -= tickSeconds;
+}
+
+void World::integrate() {
+    const float dt = tickSeconds;
+
+    spaceship.update(dt);
+
+    parallelFor(jobs, asteroids.size(), ASTEROID_CHUNK, [this, dt](std::size_t begin, std::size_t end) {
+        asteroids.storePrevious(begin, end);
+        asteroids.update(dt, begin, end);
+    });
+
+    parallelFor(jobs, bullets.size(), BULLET_CHUNK, [this, dt](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b) {
+            bullets[b].update(dt);
+        }
+    });
+}
+
+bool World::overlapsAsteroid(const CollisionShape& shape, sf::Vector2f position, float rotation, std::size_t i) const {
+    const CollisionShape& asteroid = asteroidShapes[static_cast<int>(asteroids.getKind(i))];
+    return shapesOverlap(shape, position, rotation, asteroid, asteroids.getPosition(i), asteroids.getRotation(i));
+}
+
+bool World::sweepAsteroid(const CollisionShape& shape, const Sweep& path, std::size_t i, float& time) const {
+    const CollisionShape& asteroid = asteroidShapes[static_cast<int>(asteroids.getKind(i))];
+    Sweep asteroidPath = { asteroids.getPreviousPosition(i), asteroids.getPosition(i), asteroids.getPreviousRotation(i), asteroids.getRotation(i) };
+    return sweepShapes(shape, path, asteroid, asteroidPath, time);
+}
+
+void World::resolveCollisions() {
+    // Handle Asteroid - Spaceship collision
+    if (spaceship.canCollide()) {
+        sf::FloatRect shipBox = circleBounds(spaceship.getPosition(), shipShape.getRadius());
+        asteroidGrid.query(shipBox, candidates);
+
+        for (std::size_t i : candidates) {
+            if (overlapsAsteroid(shipShape, spaceship.getPosition(), spaceship.getRotation(), i)) {
+                spaceship.Collision();
+
+                // Create explosion at the asteroid's position
+                explosions.add(asteroids.getPosition(i), tick);
+
+                // Create Heart loosing animation
+                if (spaceship.getLives() > 0) {
+                    float heartPosX = 20.0f + ((spaceship.getLives()) * 40.0f);  // Position of last heart
+                    float heartPosY = height - 50.0f;  // Consistent Y position
+                    hexplosions.add(sf::Vector2f(heartPosX, heartPosY), tick);
+                }
+
+                asteroids.kill(i);
+                break; // The ship can't collide again until its cooldown ends
+            }
+        }
+    }
+
+    // Handle Asteroid - Bullets collision. Bullets are swept along their path over the tick, so
+    // a fast one can't skip over a small asteroid between two ticks. Every bullet's impacts are
+    // found in parallel, then resolved earliest first: an asteroid goes to the bullet that
+    // reaches it first, and a bullet to the first asteroid still there when it arrives.
+    bulletCandidates.resize(bullets.size());
+    bulletImpacts.resize(bullets.size());
+    parallelFor(jobs, bullets.size(), BULLET_CHUNK, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b) {
+            std::vector<Impact>& hits = bulletImpacts[b];
+            hits.clear();
+            if (!bullets[b].isActive()) continue;
+
+            const Bullet& bullet = bullets[b];
+            Sweep path = { bullet.getPreviousPosition(), bullet.getPosition(), bullet.getRotation(), bullet.getRotation() };
+            sf::FloatRect bulletBox = sweptBounds(path.start, path.end, bulletShape.getRadius());
+            asteroidGrid.queryShared(bulletBox, bulletCandidates[b]);
+            for (std::size_t i : bulletCandidates[b]) {
+                float time;
+                if (sweepAsteroid(bulletShape, path, i, time)) {
+                    hits.push_back({ time, static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(i) });
+                }
+            }
+        }
+    });
+
+    impacts.clear();
+    for (const std::vector<Impact>& hits : bulletImpacts) {
+        impacts.insert(impacts.end(), hits.begin(), hits.end());
+    }
+    std::sort(impacts.begin(), impacts.end(), [](const Impact& a, const Impact& b) {
+        if (a.time != b.time) return a.time < b.time;
+        return a.bullet != b.bullet ? a.bullet < b.bullet : a.asteroid < b.asteroid;
+    });
+
+    for (const Impact& impact : impacts) {
+        if (!bullets.isAlive(impact.bullet) || !asteroids.isAlive(impact.asteroid)) continue;
+
+        // Create explosion at asteroid's position
+        explosions.add(asteroids.getPosition(impact.asteroid), tick);
+
+        // Both are gone; a bullet destroys one asteroid at most
+        asteroids.kill(impact.asteroid);
+        bullets.kill(impact.bullet);
+
+        // Large and medium asteroids break up. The pieces go at the end of the pool, past every
+        // index the impacts refer to, and collide from the next tick.
+        asteroids.split(impact.asteroid, physicsRandom);
+    }
+}
+
+void World::spawn(const InputFrame& input) {
+    // Spawn new asteroids, as many as the wave table asks for by now
+    for (std::size_t count = director.update(tickSeconds, asteroids.getAliveCount()); count > 0; --count) {
+        spawnAsteroid();
+    }
+
+    // Checks for bullets shooted
+    if (input.fire && bullet_cooldown <= 0.0f && fireBullet()) {
+        bullet_cooldown = BULLET_COOLDONW;
+    }
+}
+
+void World::cull() {
+    // Retire expired and off-screen bullets
+    for (std::size_t b = 0; b < bullets.size(); ++b) {
+        if (!bullets[b].isActive() || bullets[b].isOutOfScreen(width, height)) {
+            bullets.kill(b);
+        }
+    }
+
+    // Removes out-of-screen asteroids
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        if (asteroids.isOutOfScreen(i, width, height)) {
+            asteroids.kill(i);
+        }
+    }
+
+    // Removes finished explosions and heart animations
+    explosions.cull(tick);
+    hexplosions.cull(tick);
+
+    // Everything killed this tick goes away in one pass per collection
+    asteroids.compact();
+    bullets.compact();
+}
+
+void World::spawnAsteroid() {
+    AsteroidSize size = director.pickSize(spawnRandom);
+    Asteroid newAsteroid(size, config.asteroidSizes[static_cast<int>(size)], ASTEROID_SCALE.x, ASTEROID_SCALE.y);
+    newAsteroid.appear(spawnRandom, physicsRandom, width, height, director.getSpeed());
+    asteroids.add(newAsteroid);
+}
+
+bool World::fireBullet() {
+    float spaceshipAngle = spaceship.getRotation(); // Get rotation in degrees
+
+    // Get spaceship tip position
+    sf::Vector2f spaceshipPos = spaceship.getPosition();
+    float spaceshipLength = spaceship.getBounds().size.y / 2.0f; // Half of the spaceship height (assuming it's vertical)
+
+    // Convert angle to radians for offset calculation
+    float radian = (spaceshipAngle - 90) * 3.14159f / 180.0f;
+
+    // Calculate tip position
+    sf::Vector2f bulletSpawnPos = spaceshipPos + sf::Vector2f(std::cos(radian) * spaceshipLength, std::sin(radian) * spaceshipLength);
+
+    // Spawn bullet at the tip, if the pool has a free slot
+    return bullets.add(config.bulletSize, bulletSpawnPos, spaceshipAngle) != nullptr;
+}
+
+void World::reset() {
+    spaceship.reset();
+    asteroids.clear();
+    director.reset();
+}
+
+namespace {
+    void captureAnimations(const AnimationPool& animations, std::uint64_t tick, std::vector<RenderSnapshot::AnimationFrame>& out) {
+        out.resize(animations.size());
+        for (std::size_t i = 0; i < animations.size(); ++i) {
+            out[i] = { animations.getPosition(i), animations.getStartTick(i), static_cast<std::uint8_t>(animations.getFrame(i, tick)) };
+        }
+    }
+}
+
+void World::capture(RenderSnapshot& snapshot) const {
+    snapshot.tick = tick;
+    snapshot.tickSeconds = tickSeconds;
+
+    snapshot.ship = { spaceship.getPreviousPosition(), spaceship.getPosition(), spaceship.getPreviousRotation(), spaceship.getRotation() };
+    snapshot.shipScale = spaceship.getScale();
+    snapshot.shipVelocity = spaceship.getVelocity();
+    snapshot.shipVulnerable = spaceship.canCollide();
+    snapshot.lives = spaceship.getLives();
+
+    snapshot.asteroids.resize(asteroids.size());
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        RenderSnapshot::AsteroidSprite& sprite = snapshot.asteroids[i];
+        sprite.pose = { asteroids.getPreviousPosition(i), asteroids.getPosition(i), asteroids.getPreviousRotation(i), asteroids.getRotation(i) };
+        sprite.scale = asteroids.getScale(i);
+        sprite.kind = static_cast<std::uint8_t>(asteroids.getKind(i));
+    }
+
+    snapshot.bullets.clear();
+    for (const Bullet& bullet : bullets) {
+        if (!bullet.isActive()) continue;
+        snapshot.bullets.push_back({ bullet.getPreviousPosition(), bullet.getPosition(), bullet.getRotation(), bullet.getRotation() });
+    }
+
+    captureAnimations(explosions, tick, snapshot.explosions);
+    captureAnimations(hexplosions, tick, snapshot.hearts);
+}
+
+namespace {
+    const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * FNV_PRIME;
+        }
+    }
+
+    template <typename T>
+    void hashValue(std::uint64_t& hash, const T& value) {
+        hashBytes(hash, &value, sizeof(T));
+    }
+
+    void hashVector(std::uint64_t& hash, sf::Vector2f value) {
+        hashValue(hash, value.x);
+        hashValue(hash, value.y);
+    }
+}
+
+std::uint64_t World::stateHash() const {
+    std::uint64_t hash = FNV_OFFSET;
+
+    hashValue(hash, tick);
+    hashValue(hash, director.getElapsed());
+    hashValue(hash, bullet_cooldown);
+
+    hashVector(hash, spaceship.getPosition());
+    hashVector(hash, spaceship.getVelocity());
+    hashValue(hash, spaceship.getRotation());
+    hashValue(hash, spaceship.getLives());
+
+    hashValue(hash, static_cast<std::uint64_t>(asteroids.size()));
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        hashVector(hash, asteroids.getPosition(i));
+        hashVector(hash, asteroids.getVelocity(i));
+        hashValue(hash, asteroids.getRotation(i));
+    }
+
+    hashValue(hash, static_cast<std::uint64_t>(bullets.size()));
+    for (const Bullet& bullet : bullets) {
+        hashVector(hash, bullet.getPosition());
+    }
+
+    hashValue(hash, static_cast<std::uint64_t>(explosions.size()));
+    hashValue(hash, static_cast<std::uint64_t>(hexplosions.size()));
+    return hash;
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AnimationPool.h"
+#include "AsteroidPool.h"
+#include "CollisionMask.h"
+#include "Entities.h"
+#include "EntityList.h"
+#include "Input.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include "RenderSnapshot.h"
+#include "SpatialGrid.h"
+#include "SpriteMasks.h"
+#include "SystemTimings.h"
+#include "WaveDirector.h"
+
+// Sizes and shapes the simulation needs from the sprite sheets. The defaults come from
+// SpriteMasks.h, generated from the files in Sprites/, so headless runs don't have to load any
+// texture; the game overwrites them with the ones it loaded.
+struct WorldConfig {
+    sf::Vector2f shipSize = sf::Vector2f(SPACESHIP3_SIZE);
+    sf::Vector2f bulletSize = sf::Vector2f(BULLET1_SIZE);
+    sf::Vector2f asteroidSizes[3] = { sf::Vector2f(ASTEROID_SMALL_SIZE),
+                                      sf::Vector2f(ASTEROID_MEDIUM_SIZE),
+                                      sf::Vector2f(ASTEROID_LARGE_SIZE) };
+
+    // Solid pixels of the same sprites, for collisions against the sprites' shapes
+    CollisionMask shipMask = CollisionMask::fromText(SPACESHIP3_SIZE, SPACESHIP3_MASK);
+    CollisionMask bulletMask = CollisionMask::fromText(BULLET1_SIZE, BULLET1_MASK);
+    CollisionMask asteroidMasks[3] = { CollisionMask::fromText(ASTEROID_SMALL_SIZE, ASTEROID_SMALL_MASK),
+                                       CollisionMask::fromText(ASTEROID_MEDIUM_SIZE, ASTEROID_MEDIUM_MASK),
+                                       CollisionMask::fromText(ASTEROID_LARGE_SIZE, ASTEROID_LARGE_MASK) };
+
+    // Live bullets at most; the pool is allocated once. One shot every BULLET_COOLDONW seconds
+    // with a lifetime of BULLET_LIFETIME never has more than 25 alive.
+    std::size_t bulletCapacity = 64;
+
+    // Live asteroids at most, pieces of shot ones included; the pool is allocated once, so
+    // splitting asteroids mid-collision never allocates. Anything beyond it is skipped.
+    std::size_t asteroidCapacity = 16384;
+
+    // Running explosion and heart animations at most; the oldest make room beyond that
+    std::size_t explosionCapacity = 256;
+    std::size_t heartCapacity = 8;
+
+    // How asteroid spawning ramps up over a game; the game loads it from Waves/default.waves
+    WaveTable waves;
+
+    // Fixed simulation rate in ticks per second (60 or 120). Gameplay speed doesn't depend on it.
+    int tickRate = DEFAULT_TICK_RATE;
+
+    // Seed of every random stream in the run; the same seed and input replay the same game
+    std::uint64_t seed = 1;
+};
+
+// All gameplay state of one run, advanced one fixed tick of 1 / tickRate seconds at a time
+// without a window. The game steps it from an accumulator of real time and interpolates the
+// drawing between ticks; SpaceGame-Headless steps it from a script as fast as it can.
+class World {
+private:
+    WorldConfig config;
+    float tickSeconds;
+    Random spawnRandom;
+    Random physicsRandom;
+    Spaceship spaceship;
+    AsteroidPool asteroids;
+    EntityList<Bullet> bullets;
+    AnimationPool explosions;
+    AnimationPool hexplosions;
+
+    WaveDirector director;
+    float bullet_cooldown = BULLET_COOLDONW;
+    std::uint64_t tick = 0;
+
+    // Masks at the scale each entity is drawn with, pre-rotated once for the whole run
+    CollisionShape shipShape;
+    CollisionShape bulletShape;
+    CollisionShape asteroidShapes[3];
+
+    // Broad phase on bounding circles, rebuilt once per tick after the asteroids move
+    SpatialGrid asteroidGrid;
+    std::vector<sf::FloatRect> asteroidBoxes;
+    std::vector<std::size_t> candidates;
+
+    // A bullet reaching an asteroid `time` of the way through the tick
+    struct Impact {
+        float time;
+        std::uint32_t bullet;
+        std::uint32_t asteroid;
+    };
+    std::vector<std::vector<std::size_t>> bulletCandidates;    // per bullet, from the grid
+    std::vector<std::vector<Impact>> bulletImpacts;            // per bullet, asteroids on its path
+    std::vector<Impact> impacts;                                // all of them, earliest first
+
+    // Splits integrate, broad phase and bullet collisions over threads when set
+    JobSystem* jobs = nullptr;
+
+    SystemTimings timings;
+
+    // The systems of one tick, in the order step() runs them
+    void applyInput(const InputFrame& input);
+    void integrate();
+    void updateBroadPhase();
+    void resolveCollisions();
+    void spawn(const InputFrame& input);
+    void cull();
+
+    // Pixel test of a shape against asteroid i, bounding circles first
+    bool overlapsAsteroid(const CollisionShape& shape, sf::Vector2f position, float rotation, std::size_t i) const;
+
+    // Continuous test of a shape moving along `path` against asteroid i's move over the tick
+    bool sweepAsteroid(const CollisionShape& shape, const Sweep& path, std::size_t i, float& time) const;
+
+    bool fireBullet();
+    void spawnAsteroid();
+
+public:
+    explicit World(const WorldConfig& config = WorldConfig());
+
+    // The director reads the wave table in this world's config, so a World stays where it was built
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+    World(World&&) = delete;
+    World& operator=(World&&) = delete;
+
+    // Advances the game by one tick: input, integrate, broad phase, collisions, spawn, cull
+    void step(const InputFrame& input);
+
+    // Back to a fresh ship after death, with the asteroids cleared and the difficulty back at the
+    // start of the wave table. Like the old game loop, bullets and effects carry over.
+    void reset();
+
+    bool isShipDestroyed() const { return spaceship.getLives() <= 0; }
+
+    // Copies what the renderer needs into `snapshot`, reusing its storage
+    void capture(RenderSnapshot& snapshot) const;
+
+    // FNV-1a hash of the simulation state, for comparing runs
+    std::uint64_t stateHash() const;
+
+    std::uint64_t getTick() const { return tick; }
+    int getTickRate() const { return config.tickRate; }
+    std::uint64_t getSeed() const { return config.seed; }
+    float getTickSeconds() const { return tickSeconds; }
+    const Spaceship& getSpaceship() const { return spaceship; }
+    const AsteroidPool& getAsteroids() const { return asteroids; }
+    const EntityList<Bullet>& getBullets() const { return bullets; }
+    const AnimationPool& getExplosions() const { return explosions; }
+    const AnimationPool& getHeartAnimations() const { return hexplosions; }
+    const WaveDirector& getDirector() const { return director; }
+    const CollisionShape& getShipShape() const { return shipShape; }
+    const CollisionShape& getBulletShape() const { return bulletShape; }
+    const CollisionShape& getAsteroidShape(AsteroidSize size) const { return asteroidShapes[static_cast<int>(size)]; }
+
+    // Time spent in each system since the world was created
+    const SystemTimings& getTimings() const { return timings; }
+
+    // Runs the data-parallel parts of a tick on these threads; null runs everything on the
+    // calling thread. Results are the same either way.
+    void setJobSystem(JobSystem* jobs) { this->jobs = jobs; }
+
+    // Also report each system's time to the profiler's current frame; null to stop
+    void setProfiler(Profiler* profiler) { timings.attach(profiler); }
+
+    FrameCounts getCounts() const { return { asteroids.size(), bullets.size(), explosions.size() + hexplosions.size() }; }
+};
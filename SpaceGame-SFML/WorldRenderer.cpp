@@ -0,0 +1,260 @@
+#include "WorldRenderer.h"
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const char* SPACESHIP_PATH = "Sprites/Spaceship3.png";
+    const char* LIFE_PATH = "Sprites/Life.png";
+    const char* BULLET_PATH = "Sprites/bullet1.png";
+    const char* EXPLOSION_PATH = "Sprites/Explosion.png";
+    const char* LIFE_ANIMATION_PATH = "Sprites/LifeAnimation.png";
+    const char* ASTEROID_PATHS[3] = { "Sprites/AsteroidSmall.png", "Sprites/AsteroidMedium.png", "Sprites/AsteroidLarge.png" };
+
+    // Room for far more particles than a game makes, so a busy fight never drops any
+    const std::size_t PARTICLE_CAPACITY = 65536;
+    const std::size_t DEBRIS_PER_EXPLOSION = 48;
+    const float TRAIL_RATE = 240.0f;        // trail particles per second at full speed
+    const float TRAIL_MIN_SPEED = 20.0f;    // slower than this leaves no trail
+    const float MAX_PARTICLE_STEP = 0.25f;  // seconds; longer gaps (a new game) aren't played out
+
+    // Solid pixels of one sprite in the atlas image
+    CollisionMask maskOf(const sf::Image& atlas, const sf::IntRect& rect) {
+        if (rect.size.x <= 0 || rect.size.y <= 0) return CollisionMask();
+        std::size_t stride = atlas.getSize().x * 4;
+        const std::uint8_t* pixels = atlas.getPixelsPtr() + rect.position.y * stride + rect.position.x * 4;
+        return CollisionMask::fromPixels(rect.size, pixels, stride);
+    }
+
+    // The sprites in SpriteMasks.h and the names of their constants there
+    struct MaskedSprite {
+        const char* path;
+        const char* name;
+    };
+    const MaskedSprite MASKED_SPRITES[] = {
+        { SPACESHIP_PATH, "SPACESHIP3" }, { BULLET_PATH, "BULLET1" }, { ASTEROID_PATHS[0], "ASTEROID_SMALL" },
+        { ASTEROID_PATHS[1], "ASTEROID_MEDIUM" }, { ASTEROID_PATHS[2], "ASTEROID_LARGE" },
+    };
+
+    sf::Vector2f centerOf(const sf::IntRect& rect) {
+        return { rect.size.x / 2.0f, rect.size.y / 2.0f };
+    }
+
+    // A jump of more than half the playfield in one tick is the ship wrapping around the edge,
+    // which should snap rather than slide across the screen
+    sf::Vector2f interpolate(sf::Vector2f previous, sf::Vector2f current, float alpha) {
+        sf::Vector2f delta = current - previous;
+        if (std::abs(delta.x) > width / 2.0f || std::abs(delta.y) > height / 2.0f) {
+            return current;
+        }
+        return previous + delta * alpha;
+    }
+
+    // Turns the short way round, so 350 -> 10 goes through 0 instead of 180
+    float interpolateAngle(float previous, float current, float alpha) {
+        float delta = current - previous;
+        if (delta > 180.0f) delta -= 360.0f;
+        if (delta < -180.0f) delta += 360.0f;
+        return previous + delta * alpha;
+    }
+}
+
+std::vector<std::string> WorldRenderer::getSpritePaths() {
+    return { SPACESHIP_PATH, LIFE_PATH, BULLET_PATH, EXPLOSION_PATH, LIFE_ANIMATION_PATH,
+             ASTEROID_PATHS[0], ASTEROID_PATHS[1], ASTEROID_PATHS[2] };
+}
+
+WorldRenderer::WorldRenderer(TextureCache& textures, const AssetPack* pack) : particles(PARTICLE_CAPACITY) {
+    if (!pack || !atlas.load(textures, *pack, getSpritePaths())) {
+        atlas.build(textures, getSpritePaths());
+    }
+    findRegions();
+    createParticleBuffer();
+}
+
+WorldRenderer::WorldRenderer(TextureAtlas atlas) : atlas(std::move(atlas)), particles(PARTICLE_CAPACITY) {
+    findRegions();
+    createParticleBuffer();
+}
+
+void WorldRenderer::findRegions() {
+    shipRect = atlas.getRegion(SPACESHIP_PATH);
+    lifeRect = atlas.getRegion(LIFE_PATH);
+    bulletRect = atlas.getRegion(BULLET_PATH);
+    explosionFrames = makeFrameTable(EXPLOSION_ANIMATION, atlas.getRegion(EXPLOSION_PATH));
+    heartFrames = makeFrameTable(HEART_ANIMATION, atlas.getRegion(LIFE_ANIMATION_PATH));
+    for (int i = 0; i < 3; ++i) {
+        asteroidRects[i] = atlas.getRegion(ASTEROID_PATHS[i]);
+    }
+}
+
+void WorldRenderer::createParticleBuffer() {
+    // Sized for every particle at once, so streaming a frame in never reallocates it
+    particleVertices.reserve(PARTICLE_CAPACITY * 3);
+    particleBufferReady = sf::VertexBuffer::isAvailable() && particleBuffer.create(PARTICLE_CAPACITY * 3);
+    if (!particleBufferReady) {
+        std::cerr << "ERROR: COULD NOT CREATE PARTICLE VERTEX BUFFER, DRAWING PARTICLES FROM MEMORY\n";
+    }
+}
+
+WorldConfig WorldRenderer::makeConfig() const {
+    WorldConfig config;
+    config.shipSize = sf::Vector2f(shipRect.size);
+    config.bulletSize = sf::Vector2f(bulletRect.size);
+    for (int i = 0; i < 3; ++i) {
+        config.asteroidSizes[i] = sf::Vector2f(asteroidRects[i].size);
+    }
+
+    // The masks come from the pixels that were actually loaded, read back from the atlas once
+    sf::Image pixels = atlas.getTexture().copyToImage();
+    config.shipMask = maskOf(pixels, shipRect);
+    config.bulletMask = maskOf(pixels, bulletRect);
+    for (int i = 0; i < 3; ++i) {
+        config.asteroidMasks[i] = maskOf(pixels, asteroidRects[i]);
+    }
+    return config;
+}
+
+std::string WorldRenderer::makeMaskSource(const TextureAtlas::Packed& packed) {
+    std::ostringstream source;
+    source << "#pragma once\n"
+           << "#include <SFML/System/Vector2.hpp>\n"
+           << "\n"
+           << "// Generated by `SpaceGame-SFML --dump-masks` from the files in Sprites/; don't edit by hand.\n"
+           << "// Size and solid pixels of every sprite the simulation collides, as CollisionMask::fromText()\n"
+           << "// reads them. WorldConfig's defaults come from here, so headless runs get the same collisions\n"
+           << "// as the game without loading any texture. Regenerate after changing a sprite, or recordings\n"
+           << "// of the game won't replay the same headless.\n";
+
+    for (const MaskedSprite& sprite : MASKED_SPRITES) {
+        auto region = packed.regions.find(sprite.path);
+        sf::IntRect rect = region != packed.regions.end() ? region->second : sf::IntRect();
+        std::string rows = maskOf(packed.image, rect).toText();
+
+        source << "\n// " << std::filesystem::path(sprite.path).filename().string() << "\n"
+               << "const sf::Vector2i " << sprite.name << "_SIZE = { " << rect.size.x << ", " << rect.size.y << " };\n"
+               << "const char* const " << sprite.name << "_MASK =";
+        for (int y = 0; y < rect.size.y; ++y) {
+            source << "\n    \"" << rows.substr(static_cast<std::size_t>(y) * rect.size.x, rect.size.x) << "\"";
+        }
+        source << (rows.empty() ? " \"\";\n" : ";\n");
+    }
+    return source.str();
+}
+
+void WorldRenderer::addAnimation(SpriteBatch& batch, const std::vector<sf::IntRect>& frames, const RenderSnapshot::AnimationFrame& animation) {
+    if (animation.frame >= frames.size()) return;
+    const sf::IntRect& frame = frames[animation.frame];
+    batch.add(frame, animation.position, centerOf(frame), { 4.0f, 4.0f });
+}
+
+void WorldRenderer::draw(sf::RenderTarget& target, const World& world, float alpha) {
+    world.capture(snapshot);
+    draw(target, snapshot, alpha);
+}
+
+void WorldRenderer::draw(sf::RenderTarget& target, const RenderSnapshot& frame, float alpha) {
+    timings.run(System::RenderPrep, [&] { prepare(frame, alpha); });
+
+    drawCalls = 0;
+    for (int layer = 0; layer < LayerCount; ++layer) {
+        // Under the ship, so its trail comes out from beneath it
+        if (layer == Ship) drawCalls += drawParticles(target);
+        drawCalls += layers[layer].draw(target, atlas.getTexture());
+    }
+}
+
+std::size_t WorldRenderer::drawParticles(sf::RenderTarget& target) {
+    if (particleVertices.empty()) return 0;
+
+    // Untextured and added onto what's below, so overlapping sparks glow
+    sf::RenderStates states;
+    states.blendMode = sf::BlendAdd;
+    if (particleBufferReady && particleBuffer.update(particleVertices.data(), particleVertices.size(), 0)) {
+        target.draw(particleBuffer, 0, particleVertices.size(), states);
+    }
+    else {
+        target.draw(particleVertices.data(), particleVertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+    return 1;
+}
+
+void WorldRenderer::updateParticles(const RenderSnapshot& frame, float alpha) {
+    double now = (frame.tick + alpha) * static_cast<double>(frame.tickSeconds);
+
+    // A snapshot from before the last one is another World; start over from it
+    if (!particlesStarted || frame.tick < particleTick) {
+        particles.clear();
+        particleTick = frame.tick;
+        particleTime = now;
+        particlesStarted = true;
+    }
+    float dt = static_cast<float>(std::clamp(now - particleTime, 0.0, static_cast<double>(MAX_PARTICLE_STEP)));
+    particleTime = now;
+
+    // Debris for every explosion that started after the last tick emitted for. Snapshots can be
+    // skipped or shown twice, so it goes by the explosion's start tick rather than its frame.
+    std::uint64_t newTicks = frame.tick - particleTick;
+    for (const RenderSnapshot::AnimationFrame& explosion : frame.explosions) {
+        std::uint32_t age = static_cast<std::uint32_t>(frame.tick) - explosion.startTick;
+        if (age < newTicks) particles.burst(DEBRIS_PARTICLES, explosion.position, DEBRIS_PER_EXPLOSION);
+    }
+    particleTick = frame.tick;
+
+    // Exhaust behind the ship, thicker the faster it goes
+    sf::Vector2f velocity = frame.shipVelocity;
+    float speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    if (speed > TRAIL_MIN_SPEED) {
+        trailBudget += TRAIL_RATE * std::min(speed / MAX_SPEED, 1.0f) * dt;
+        std::size_t count = static_cast<std::size_t>(trailBudget);
+        trailBudget -= static_cast<float>(count);
+
+        sf::Vector2f backwards = -velocity / speed;
+        sf::Vector2f position = interpolate(frame.ship.previousPosition, frame.ship.position, alpha);
+        sf::Vector2f exhaust = position + backwards * (shipRect.size.y * frame.shipScale.y / 4.0f);  // a quarter ship behind
+        float heading = std::atan2(backwards.y, backwards.x) * 180.0f / 3.14159f;
+        particles.spray(THRUSTER_PARTICLES, exhaust, heading, 15.0f, count);
+    }
+    else {
+        trailBudget = 0.0f;
+    }
+
+    particles.update(dt);
+    particles.fill(particleVertices);
+}
+
+void WorldRenderer::prepare(const RenderSnapshot& frame, float alpha) {
+    for (SpriteBatch& layer : layers) {
+        layer.clear();
+    }
+
+    for (const RenderSnapshot::AsteroidSprite& asteroid : frame.asteroids) {
+        const sf::IntRect& rect = asteroidRects[asteroid.kind];
+        sf::Vector2f position = interpolate(asteroid.pose.previousPosition, asteroid.pose.position, alpha);
+        float rotation = interpolateAngle(asteroid.pose.previousRotation, asteroid.pose.rotation, alpha);
+        layers[Asteroids].add(rect, position, centerOf(rect), asteroid.scale, rotation);
+    }
+
+    for (const RenderSnapshot::Pose& bullet : frame.bullets) {
+        sf::Vector2f position = interpolate(bullet.previousPosition, bullet.position, alpha);
+        layers[Bullets].add(bulletRect, position, centerOf(bulletRect), { 1.0f, 1.0f }, bullet.rotation);
+    }
+
+    sf::Color shipColor = frame.shipVulnerable ? sf::Color(255, 255, 255, 255) : sf::Color(255, 255, 255, 120);
+    sf::Vector2f shipPosition = interpolate(frame.ship.previousPosition, frame.ship.position, alpha);
+    float shipRotation = interpolateAngle(frame.ship.previousRotation, frame.ship.rotation, alpha);
+    layers[Ship].add(shipRect, shipPosition, centerOf(shipRect), frame.shipScale, shipRotation, shipColor);
+
+    for (const RenderSnapshot::AnimationFrame& explosion : frame.explosions) {
+        addAnimation(layers[Effects], explosionFrames, explosion);
+    }
+    for (const RenderSnapshot::AnimationFrame& heart : frame.hearts) {
+        addAnimation(layers[Effects], heartFrames, heart);
+    }
+
+    updateParticles(frame, alpha);
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AnimationPool.h"
+#include "AssetPack.h"
+#include "ParticleSystem.h"
+#include "RenderSnapshot.h"
+#include "SpriteBatch.h"
+#include "SystemTimings.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+#include "World.h"
+
+// Draws a World. All sprite sheets are packed into one atlas and every entity becomes a quad in
+// its layer's vertex array, so a frame costs one draw call per non-empty layer no matter how
+// many entities there are. Quads are rebuilt from a RenderSnapshot of the simulation every frame,
+// placed between the previous and the current tick so motion stays smooth when frames and ticks
+// don't line up. Drawing only reads the snapshot, so the simulation can run on another thread.
+// Lives and the timer aren't drawn here but by the Hud, which keeps them between frames.
+//
+// Explosion debris and the ship's engine trail are particles, kept here rather than in the
+// World because they're only for show. They're advanced by the simulation time the frames show,
+// so they freeze with the game, and drawn from one streamed vertex buffer in one draw call.
+class WorldRenderer {
+public:
+    enum Layer { Asteroids, Bullets, Ship, Effects, LayerCount };
+
+private:
+    TextureAtlas atlas;
+    sf::IntRect shipRect;
+    sf::IntRect lifeRect;
+    sf::IntRect bulletRect;
+    std::vector<sf::IntRect> explosionFrames;   // texture rect per animation frame
+    std::vector<sf::IntRect> heartFrames;
+    sf::IntRect asteroidRects[3];
+
+    SpriteBatch layers[LayerCount];
+    std::size_t drawCalls = 0;
+    SystemTimings timings;
+    RenderSnapshot snapshot;    // for drawing a World directly
+
+    ParticleSystem particles;
+    std::vector<sf::Vertex> particleVertices;
+    sf::VertexBuffer particleBuffer{ sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Stream };
+    bool particleBufferReady = false;   // false draws the vertices straight from memory instead
+    bool particlesStarted = false;
+    std::uint64_t particleTick = 0;     // last tick the particles were emitted for
+    double particleTime = 0.0;          // simulation time of the last frame, in seconds
+    float trailBudget = 0.0f;           // fraction of a trail particle carried to the next frame
+
+    void findRegions();
+    void createParticleBuffer();
+
+    // Emits for what happened since the last frame and advances the particles to this one
+    void updateParticles(const RenderSnapshot& frame, float alpha);
+    std::size_t drawParticles(sf::RenderTarget& target);
+
+    // Fills the layers from a snapshot (the render-prep system)
+    void prepare(const RenderSnapshot& frame, float alpha);
+    void addAnimation(SpriteBatch& batch, const std::vector<sf::IntRect>& frames, const RenderSnapshot::AnimationFrame& animation);
+
+public:
+    // Takes the atlas from `pack` when it has one, otherwise decodes and packs the sprite files
+    explicit WorldRenderer(TextureCache& textures, const AssetPack* pack = nullptr);
+
+    // Uses an atlas that is already built and uploaded, e.g. from pixels an AssetLoader packed
+    explicit WorldRenderer(TextureAtlas atlas);
+
+    // Every sprite sheet the renderer draws from, for packing them offline
+    static std::vector<std::string> getSpritePaths();
+
+    // World settings matching the loaded sprite sizes and collision masks
+    WorldConfig makeConfig() const;
+
+    // C++ source of SpriteMasks.h: the size and collision mask of every sprite the simulation
+    // collides, read from a packed atlas the way makeConfig() reads them
+    static std::string makeMaskSource(const TextureAtlas::Packed& packed);
+
+    // alpha is how far the frame is between the last two ticks, from 0 (previous) to 1 (current)
+    void draw(sf::RenderTarget& target, const RenderSnapshot& frame, float alpha = 1.0f);
+
+    // Takes a snapshot of the world and draws it, for when both run on the same thread
+    void draw(sf::RenderTarget& target, const World& world, float alpha = 1.0f);
+
+    // Draw calls issued by the last draw()
+    std::size_t getDrawCallCount() const { return drawCalls; }
+
+    std::size_t getSpriteCount(Layer layer) const { return layers[layer].getSpriteCount(); }
+    std::size_t getParticleCount() const { return particles.size(); }
+
+    // The atlas and where the life icon is in it, for the Hud
+    const sf::Texture& getAtlasTexture() const { return atlas.getTexture(); }
+    sf::IntRect getLifeRegion() const { return lifeRect; }
+
+    // Time spent building the layers, under System::RenderPrep
+    const SystemTimings& getTimings() const { return timings; }
+    void setProfiler(Profiler* profiler) { timings.attach(profiler); }
+};
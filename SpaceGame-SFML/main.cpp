@@ -7,496 +7,170 @@
 #include <sstream>
 #include <optional>
 #include <cstdlib>
+#include <cstdint>
+#include <ctime>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Audio.hpp>
 #include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include "GameConstants.h"
+#include "Hud.h"
+#include "InputRecording.h"
+#include "JobSystem.h"
+#include "MusicStream.h"
+#include "Profiler.h"
+#include "SimulationThread.h"
+#include "TripleBuffer.h"
+#include "Random.h"
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+#include "World.h"
+#include "WorldRenderer.h"
 
 using namespace sf;
 
-unsigned int width = 800;
-unsigned int height = 800;
-
-const float ASTEROID_SPAWN_TIME = 3.0F;
-const float BULLET_COOLDONW = 0.5f;
-
-const float ACCELERATION = 0.2f;
-const float DRAG = 0.02f;
-const float MAX_SPEED = 6.0f;
-
 bool isGameStarted;
 
 using namespace sf;
 
-class Animation {
-private:
-    sf::Sprite sprite;
-    sf::Clock clock;
-    bool finished = false;
-    int currentFrame = 0;
-    float frameDuration;
-    int frameCount;
-    int frameWidth;
-    int frameHeight;
-    bool loopable;
-
-public:
-
-    Animation(sf::Texture& texture, sf::Vector2f position, int frameCount, int frameWidth, int frameHeight, float frameTime = 0.1f, bool loopable = false)
-        : sprite(texture), frameCount(frameCount), frameWidth(frameWidth), frameHeight(frameHeight), frameDuration(frameTime), loopable(loopable) {
-        sprite.setOrigin({ frameWidth / 2.0f, frameHeight / 2.0f });
-        sprite.setScale({ 4.0f, 4.0f });
-        sprite.setPosition(position);
-        sprite.setTextureRect(IntRect({ 0, 0 }, { frameWidth, frameHeight }));
-    }
-
-    void update() {
-        if (finished) return;
-
-        if (clock.getElapsedTime().asSeconds() >= frameDuration) {
-            clock.restart();
-            currentFrame++;
-
-            if (currentFrame >= frameCount) {
-                if (loopable) {
-                    currentFrame = 0;
-                }
-                else {
-                    finished = true;
-                    return;
-                }
-            }
-
-            sprite.setTextureRect(IntRect({ currentFrame * frameWidth, 0 }, { frameWidth, frameHeight }));
-        }
-    }
-
-
-    void draw(sf::RenderWindow& window) {
-        if (!finished) {
-            window.draw(sprite);
-        }
-    }
-
-    bool isFinished() const {
-        return finished;
-    }
-};
+enum class MenuType { Main, Dead, Options};
 
-class Asteroid {
+// Frame-time percentiles, average time per zone and entity counts from the profiler, drawn
+// over the game, with how often the HUD had to rebuild anything. The text is rebuilt twice a
+// second so reading it doesn't skew the numbers.
+class ProfilerOverlay {
 private:
-    Sprite sprite;
-    Vector2f velocity; 
-    float rotationSpeed;
-    float x_scale, y_scale;
-    bool collided;
-    bool large;
+    Text text;
+    Clock refresh;
+    bool empty = true;
 
 public:
-    Asteroid(Texture& texture, float x_scale, float y_scale, bool islarge = false)
-        : sprite(texture), x_scale(x_scale), y_scale(y_scale), collided(false), large(islarge) {
-
-        sprite.setColor(Color(255, 255, 255, 255));
-        sprite.setOrigin({ texture.getSize().x / 2.0f, texture.getSize().y / 2.0f });
-        sprite.setScale({ x_scale, y_scale });
-        rotationSpeed = 0.0f;
+    explicit ProfilerOverlay(const Font& font) : text(font) {
+        text.setCharacterSize(14);
+        text.setFillColor(Color(200, 211, 253));
+        text.setPosition({ 10, 10 });
     }
 
-    Sprite& getSprite() { return sprite; }
-    Vector2f getVelocity() { return velocity; }
-    float getScaleX() { return x_scale; }
-    bool isLarge() { return large; }
-
-    void resetCollisionFlag() { collided = false; }
-    void setCollided() { collided = true; }
-    bool hasCollided() const { return collided; }
+    void update(const Profiler& profiler, const HudCounters& hud) {
+        if (!empty && refresh.getElapsedTime() < seconds(0.5f)) return;
+        refresh.restart();
+        empty = false;
 
-    void setVelocity(Vector2f velocity) { this->velocity = velocity; }
-
-    void appear(unsigned windowWidth, unsigned windowHeight) {
-        int side = rand() % 4;
-        float spawnX = 0, spawnY = 0;
-        float centerX = windowWidth / 2.0f;
-        float centerY = windowHeight / 2.0f;
-
-        float offsetX = (rand() % 301 - 100);
-        float offsetY = (rand() % 301 - 100);
-
-        float targetX = centerX + offsetX;
-        float targetY = centerY + offsetY;
-
-        switch (side) {
-        case 0: spawnX = 0; spawnY = rand() % static_cast<int>(windowHeight); break;
-        case 1: spawnX = windowWidth; spawnY = rand() % static_cast<int>(windowHeight); break;
-        case 2: spawnX = rand() % static_cast<int>(windowWidth); spawnY = 0; break;
-        case 3: spawnX = rand() % static_cast<int>(windowWidth); spawnY = windowHeight; break;
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(2)
+            << "frame ms  p50 " << profiler.getFramePercentile(50) << "  p95 " << profiler.getFramePercentile(95)
+            << "  p99 " << profiler.getFramePercentile(99) << "\n";
+        for (std::size_t zone = 0; zone < profiler.getZoneCount(); ++zone) {
+            stream << profiler.getZoneName(static_cast<int>(zone)) << "  " << profiler.getZoneAverage(static_cast<int>(zone)) << "\n";
         }
-        sprite.setPosition({ spawnX, spawnY });
-
-        float deltaX = targetX - spawnX;
-        float deltaY = targetY - spawnY;
-        float distance = std::sqrt(deltaX * deltaX + deltaY * deltaY);
-
-        float speedMultiplier = 1.5f;  // Example multiplier to increase speed by 50%
-
-        if (distance != 0) {
-            float baseSpeed = (0.8f + (rand() % 100) / 100.0f * 0.5f);
-            velocity.x = (deltaX / distance) * baseSpeed * speedMultiplier;
-            velocity.y = (deltaY / distance) * baseSpeed * speedMultiplier;
-        }
-
-        rotationSpeed = (rand() % 5 + 1) * (rand() % 2 == 0 ? 1 : -1);
+        const FrameCounts& counts = profiler.getLastCounts();
+        stream << "asteroids " << counts.asteroids << "  bullets " << counts.bullets << "  effects " << counts.effects << "\n";
+        stream << "hud frames " << hud.frames << "  timer rebuilds " << hud.timerRebuilds << "  heart builds " << hud.livesBuilds;
+        text.setString(stream.str());
     }
 
-    void update() {
-        sprite.move(velocity);
-        sprite.rotate(degrees(rotationSpeed));
-    }
-
-    void draw(sf::RenderWindow& window) {
-        window.draw(sprite);
-    }
-
-    bool isOutOfScreen(float windowWidth, float windowHeight, float margin = 50.0f) {
-        return sprite.getPosition().x < -margin || sprite.getPosition().x > windowWidth + margin ||
-            sprite.getPosition().y < -margin || sprite.getPosition().y > windowHeight + margin;
+    void draw(RenderWindow& window) const {
+        window.draw(text);
     }
 };
 
-class Timer {
-private:
-    Text clockText;
-    Clock clock;
-
-public:
-    Timer(const Font& font, unsigned int characterSize = 48, Vector2f position = { width / 2.0f, 55 }) : clockText(font) {
-        clockText.setFont(font);
-        clockText.setCharacterSize(characterSize);
-        clockText.setFillColor(Color(200, 211, 253));
-        clockText.setString("00:00");
-        FloatRect textBounds = clockText.getLocalBounds();
-        clockText.setOrigin(textBounds.getCenter());
-        clockText.setPosition(position);
-        clock.restart(); // Start the clock
-    }
-
-    // Returns time in seconds
-    float getElapsedTime() const {
-        return clock.getElapsedTime().asSeconds();
-    }
-
-    void update() {
-        int elapsed = static_cast<int>(clock.getElapsedTime().asSeconds());
-        int minutes = elapsed / 60;
-        int seconds = elapsed % 60;
-
-        std::ostringstream timeStream;
-        timeStream << std::setw(2) << std::setfill('0') << minutes << ":"
-            << std::setw(2) << std::setfill('0') << seconds;
-
-        clockText.setString(timeStream.str());
-    }
-
-    void draw(RenderWindow& window) {
-        window.draw(clockText);
-    }
-  
-    void reset() {
-        clock.restart(); // Restart the clock
-        clockText.setString("00:00"); // Reset the displayed time
-        update(); // Update to reflect the reset time
-    }
-
-};
+// What a menu button does when clicked
+enum class MenuAction { StartGame, Options, Return, ReturnToMenu, Exit, ToggleMusic };
 
-class Bullet {
+class MenuButton {
 private:
-    Sprite sprite;
-    Vector2f velocity;
-    Texture texture;
-    float speed = 10.0f; // Speed of the bullet
-    bool active = true;
-
-public:
-    Bullet(const Texture& texture, sf::Vector2f position, float angle) : sprite(texture){
-        sprite.setTexture(texture);
-        sprite.setOrigin({ texture.getSize().x / 2.0f, texture.getSize().y / 2.0f });
-        sprite.setPosition(position);
-        sprite.setRotation(degrees(angle));
-
-        // Convert angle to radians
-        float radian = (angle - 90) * 3.14159f / 180.0f; // SFML rotates clockwise, but we need a top-down angle
-
-        velocity.x = std::cos(radian) * speed;
-        velocity.y = std::sin(radian) * speed;
-    }
-
-    void update() {
-        if (active) {
-            sprite.move(velocity);
-        }
-    }
-
-    void draw(sf::RenderWindow& window) {
-        if (active) {
-            window.draw(sprite);
-        }
-    }
-
-    Sprite& getSprite() { return sprite; }
-
-    bool isActive() const { return active; }
-    void deactivate() { active = false; }
-    sf::FloatRect getBounds() const { return sprite.getGlobalBounds(); }
-};
-
-class Spaceship {
-protected:
-    float orientation;
-    Sprite sprite;
-    Vector2f velocity;
-    bool collide = true;
-    Clock collisionTimer;
-    unsigned int lives = 5;
-    Texture lifeTexture;
-    Texture damage_tex;
-
-public:
-    Sprite& getSprite() { return sprite; }
-
-    Spaceship(const Texture& texture, const Texture& life_tex, const Texture& life_animation) : sprite(texture), lifeTexture(life_tex)  {
-        sprite.setScale({ 4,6 });
-        sprite.setTexture(texture);
-        sprite.setOrigin({ texture.getSize().x / 2.0f, texture.getSize().y / 2.0f });
-        sprite.setPosition({ width / 2.0f, height / 2.0f });
-        orientation = 90.0f;
-        sprite.setRotation(degrees(orientation));
-    }
-
-    void handleKBInput() {
-        // Handle acceleration based on WASD keys
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::W)) {
-            velocity.y -= ACCELERATION;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::S)) {
-            velocity.y += ACCELERATION;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::A)) {
-            velocity.x -= ACCELERATION;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D)) {
-            velocity.x += ACCELERATION;
-        }
-
-        // Apply drag
-        if (velocity.x > 0) {
-            velocity.x -= DRAG;
-            if (velocity.x < 0) velocity.x = 0;
-        }
-        if (velocity.x < 0) {
-            velocity.x += DRAG;
-            if (velocity.x > 0) velocity.x = 0;
-        }
-        if (velocity.y > 0) {
-            velocity.y -= DRAG;
-            if (velocity.y < 0) velocity.y = 0;
-        }
-        if (velocity.y < 0) {
-            velocity.y += DRAG;
-            if (velocity.y > 0) velocity.y = 0;
-        }
-
-        // Limit speed
-        if (std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y) > MAX_SPEED) {
-            float angle = std::atan2(velocity.y, velocity.x);
-            velocity.x = std::cos(angle) * MAX_SPEED;
-            velocity.y = std::sin(angle) * MAX_SPEED;
-        }
-    }
-
-    void reset() {
-        // Reset position and rotation
-        sprite.setPosition({ width / 2.0f, height / 2.0f });
-        orientation = 90.0f;
-        sprite.setRotation(degrees(orientation));
-
-        // Reset movement
-        velocity = { 0.f, 0.f };
-
-        // Reset lives
-        lives = 5;
-
-        // Reset collision state
-        collide = true;
-        sprite.setColor(Color(255, 255, 255, 255)); // Full opacity
-    }
-
-
-    void displayLives(sf::RenderWindow& window) {
-        for (int i = 0; i < lives; ++i) {
-            Sprite lifeSprite(lifeTexture);
-            lifeSprite.setOrigin({ 5, 5 });
-            lifeSprite.setScale({ 3.0f, 3.0f }); // Scale smaller icons
-            lifeSprite.setPosition({ 20.0f + (i * 40.0f), height - 50.0f }); // Offset each life icon
-            window.draw(lifeSprite);
-
-        }
-    }
-
-    void handleMouseInput(const Vector2i& mousePos) {
-        // Get the position of the spaceship
-        Vector2f spaceshipPos = sprite.getPosition();
-
-        // Calculate the angle between the spaceship and the mouse cursor
-        float deltaX = mousePos.x - spaceshipPos.x;
-        float deltaY = mousePos.y - spaceshipPos.y;
-        orientation = (std::atan2(deltaY, deltaX) * 180.0f / 3.14159f) + 90.f;
-    }
-
-    void update() {
-        sprite.move(velocity);  // Apply movement (WASD)
-        sprite.setRotation(degrees(orientation));  // Rotate the sprite towards the mouse
-
-        // Check if spaceship goes out of bounds and teleport to the opposite side
-        if (sprite.getPosition().x < 0) {
-            sprite.setPosition({ static_cast<float>(width), sprite.getPosition().y });  // Teleport to the right side
-        }
-        else if (sprite.getPosition().x > static_cast<float>(width)) {
-            sprite.setPosition({ 0, sprite.getPosition().y });  // Teleport to the left side
-        }
-
-        if (sprite.getPosition().y < 0) {
-            sprite.setPosition({ sprite.getPosition().x, static_cast<float>(height) });  // Teleport to the bottom
-        }
-        else if (sprite.getPosition().y > static_cast<float>(height)) {
-            sprite.setPosition({ sprite.getPosition().x, 0 });  // Teleport to the top
-        }
-
-        if (!collide && collisionTimer.getElapsedTime().asSeconds() >= 2.0f) {
-            collide = true;
-            sprite.setColor(sf::Color(255, 255, 255, 255)); // Full opacity
-        }
-
-    }
-
-    float getOrientation() { return orientation;}
-
-    void setLives(int x) {
-        lives = x;
-    }
-
-    void Collision() {
-        if (collide) {
-            collide = false; // Disable collision
-            collisionTimer.restart(); // Start cooldown
-            sprite.setColor(Color(255, 255, 255, 120));
-        }
+    sf::Text m_text;
+    MenuAction m_action;
+    bool m_hovered = false;
 
-        if (lives > 0) {
-            lives--; // Reduce lives on collision
-        }
-    }
+    // Hit areas at normal and hover size, recomputed only when the label changes
+    sf::FloatRect m_bounds;
+    sf::FloatRect m_hoverBounds;
 
-    unsigned int getLives() { return lives; }
-    bool canCollide() { return collide; }
+    void updateBounds() {
+        // Center origin
+        sf::FloatRect bounds = m_text.getLocalBounds();
+        m_text.setOrigin({ bounds.size.x / 2.f, bounds.size.y / 2.f });
 
-    void draw(sf::RenderWindow& window) {
-        window.draw(sprite);  // Draw the sprite
-        displayLives(window);
+        m_text.setScale({ 1.2f, 1.2f });
+        m_hoverBounds = m_text.getGlobalBounds();
+        m_text.setScale({ 1.0f, 1.0f });
+        m_bounds = m_text.getGlobalBounds();
+        if (m_hovered) m_text.setScale({ 1.2f, 1.2f });
     }
-};
-
-enum class MenuType { Main, Dead, Options};
-
-class MenuButton {
-private:
-    sf::Text m_text;
-    std::string m_label;
-    bool m_wasMousePressed = false;
 
 public:
-    MenuButton(const std::string& label, float x, float y, const sf::Font& font)
-        : m_label(label), m_text(font)
+    MenuButton(const std::string& label, MenuAction action, float x, float y, const sf::Font& font)
+        : m_text(font), m_action(action)
     {
         m_text.setFont(font);
         m_text.setString(label);
         m_text.setCharacterSize(45);
         m_text.setFillColor(sf::Color::White);
         m_text.setPosition({ x, y });
-
-        // Center origin
-        sf::FloatRect bounds = m_text.getLocalBounds();
-        m_text.setOrigin({ bounds.size.x / 2.f, bounds.size.y / 2.f });
+        updateBounds();
     }
 
     void draw(sf::RenderWindow& window) const {
         window.draw(m_text);
     }
 
-    void updateScale(const sf::RenderWindow& window) {
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        sf::Vector2f worldPos = window.mapPixelToCoords(mousePos);
-
-        float scale = m_text.getGlobalBounds().contains(worldPos) ? 1.2f : 1.0f;
-        m_text.setScale({ scale, scale });
-    }
-
-    bool wasJustClicked() {
-        bool isCurrentlyPressed = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
-
-        if (isCurrentlyPressed && !m_wasMousePressed) {
-            m_wasMousePressed = true; // Just pressed
-            return true;
-        }
-
-        if (!isCurrentlyPressed) {
-            m_wasMousePressed = false; // Reset when released
-        }
-
-        return false;
+    bool contains(sf::Vector2f point) const {
+        return (m_hovered ? m_hoverBounds : m_bounds).contains(point);
     }
 
-    bool isClicked(const sf::RenderWindow& window, bool justClicked) const {
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        sf::Vector2f worldPos = window.mapPixelToCoords(mousePos);
-        return justClicked && m_text.getGlobalBounds().contains(worldPos);
+    // Grows the button while the mouse is over it; returns true if that changed anything
+    bool setHovered(bool hovered) {
+        if (hovered == m_hovered) return false;
+        m_hovered = hovered;
+        float scale = hovered ? 1.2f : 1.0f;
+        m_text.setScale({ scale, scale });
+        return true;
     }
 
-
-    const std::string& getLabel() const {
-        return m_label;
+    MenuAction getAction() const {
+        return m_action;
     }
 
     void setLabel(const std::string& newText) {
-        m_label = newText;
         m_text.setString(newText);
-
-        sf::FloatRect bounds = m_text.getLocalBounds();
-        m_text.setOrigin({ bounds.size.x / 2.f, bounds.size.y / 2.f });
+        updateBounds();
     }
 };
 
 
+// Menus are only redrawn when something on them changed: hovering or clicking a button,
+// switching menus, or the window needing a repaint. Input comes from window events instead of
+// polling the mouse, so an idle menu does no work at all.
 class Menu {
 private:
     RenderWindow& m_window;
-    Font m_font;
-    Music& m_music;
+    const Font& m_font;
+    SoundStream* m_music = nullptr;     // Null until the loader has opened it
+    bool m_musicOn = true;
+    sf::Text m_status;          // Loading progress, in the corner of every menu
     std::map<MenuType, std::vector<MenuButton>> m_buttons;
     std::map<MenuType, std::vector<sf::Text>> m_staticTexts;
     MenuType m_currentType;
     MenuType m_previousType;
 
-    bool m_wasMousePressed = false;
     bool m_isGameStarted = false;
+    bool m_dirty = true;
+    sf::Vector2f m_mouse;   // Last mouse position seen, in world coordinates
+
+    Profiler* m_profiler = nullptr;
+    int m_profileZone = 0;
 
 public:
-    Menu(RenderWindow& window, Font font, Music &music)
-        : m_window(window), m_font(font), m_music(music)
+    Menu(RenderWindow& window, const Font& font)
+        : m_window(window), m_font(font), m_status(createStaticText("", 780, 760, 20, font, false))
     {
-        if (!m_font.openFromFile("Minecraft.ttf")) {
-            std::cerr << "ERROR: COULD NOT LOAD FONT\n";
-        }
-
         // Setup menus
         setupMainMenu();
         setupOptionsMenu();
@@ -519,70 +193,62 @@ public:
         return text;
     }
 
-    bool wasJustClicked() {
-        bool isCurrentlyPressed = sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
-
-        if (isCurrentlyPressed && !m_wasMousePressed) {
-            m_wasMousePressed = true; // Just pressed
-            return true;
-        }
-
-        if (!isCurrentlyPressed) {
-            m_wasMousePressed = false; // Reset when released
-        }
-
-        return false;
-    }
-
-
     void setMenuType(MenuType type) {
         m_previousType = m_currentType;
         m_currentType = type;
+        updateHover();
+        m_dirty = true;
+    }
+
+    void setProfiler(Profiler* profiler, int zone) {
+        m_profiler = profiler;
+        m_profileZone = zone;
     }
 
+    // True when render() would draw something new
+    bool needsRedraw() const {
+        return m_dirty;
+    }
+
+    // Draws the menu if it changed since it was last shown; the window keeps the last frame otherwise
     void render() {
+        if (!m_dirty) return;
+        ProfileZone zone(m_profiler, m_profileZone);
+
         m_window.clear(sf::Color::Black);
-        for (auto& button : m_buttons[m_currentType]) {
-            button.updateScale(m_window);
+        for (const auto& button : m_buttons[m_currentType]) {
             button.draw(m_window);
         }
         for (const auto& text : m_staticTexts[m_currentType]) {
             m_window.draw(text);
         }
+        m_window.draw(m_status);
 
         m_window.display();
+        m_dirty = false;
     }
 
-    MenuButton* findButton(MenuType type, const std::string& label) {
-        for (auto& button : m_buttons[type]) {
-            if (button.getLabel() == label || button.getLabel() == "Off") {
-                return &button;
-            }
+    // Takes every window event; while the game runs it only keeps track of the mouse, so the
+    // right button is highlighted when a menu comes back
+    void handleEvent(const sf::Event& event) {
+        if (const auto* moved = event.getIf<sf::Event::MouseMoved>()) {
+            m_mouse = m_window.mapPixelToCoords(moved->position);
+            if (!m_isGameStarted) updateHover();
         }
-        return nullptr;
-    }
-
-    void handleClick() {
-        
-        bool justClicked = wasJustClicked();
+        else if (const auto* pressed = event.getIf<sf::Event::MouseButtonPressed>()) {
+            if (m_isGameStarted || pressed->button != sf::Mouse::Button::Left) return;
 
-        for (auto& button : m_buttons[m_currentType]) {
-            if (button.isClicked(m_window, justClicked)) {
-                std::string label = button.getLabel();
-                std::cout << "Clicked label: [" << label << "]\n";
-
-                if (label == "Start Game" || label == "Play Again") m_isGameStarted = true;
-                else if (label == "Options") setMenuType(MenuType::Options);
-                else if (label == "Return") setMenuType(m_previousType);
-                else if (label == "Return to Menu") setMenuType(MenuType::Main);
-                else if (label == "Exit" || label == "Quit") m_window.close();
-                else if (label == "On" || label == "Off") {
-                    bool turnOff = label == "On";
-                    m_music.setVolume(turnOff ? 0.f : 100.f);
-                    button.setLabel(label == "On" ? "Off" : "On");
+            m_mouse = m_window.mapPixelToCoords(pressed->position);
+            for (auto& button : m_buttons[m_currentType]) {
+                if (button.contains(m_mouse)) {
+                    activate(button);
+                    break;  // The action may have switched menus
                 }
             }
         }
+        else if (event.is<sf::Event::Resized>() || event.is<sf::Event::FocusGained>()) {
+            m_dirty = true;
+        }
     }
 
     bool isGameStarted() const {
@@ -590,23 +256,72 @@ public:
     }
 
     void setGameStarted(bool started) {
+        if (started != m_isGameStarted) m_dirty = true;
         m_isGameStarted = started;
+        if (!started) updateHover();
     }
 
     bool isMusicOn() const {
-        return m_music.getVolume() > 0.f;
+        return m_musicOn;
+    }
+
+    // Hands over the music once it has loaded; it starts muted if music was switched off before
+    void setMusic(SoundStream* music) {
+        m_music = music;
+        if (m_music && !m_musicOn) m_music->setVolume(0.f);
+    }
+
+    // Shown right-aligned in the bottom corner; empty hides it
+    void setStatus(const std::string& status) {
+        m_status.setString(status);
+        m_status.setOrigin({ m_status.getLocalBounds().size.x, 0.f });
+        m_dirty = true;
     }
 
 private:
+    void updateHover() {
+        for (auto& button : m_buttons[m_currentType]) {
+            if (button.setHovered(button.contains(m_mouse))) m_dirty = true;
+        }
+    }
+
+    void activate(MenuButton& button) {
+        switch (button.getAction()) {
+        case MenuAction::StartGame:
+            setGameStarted(true);
+            break;
+        case MenuAction::Options:
+            setMenuType(MenuType::Options);
+            break;
+        case MenuAction::Return:
+            setMenuType(m_previousType);
+            break;
+        case MenuAction::ReturnToMenu:
+            setMenuType(MenuType::Main);
+            break;
+        case MenuAction::Exit:
+            m_window.close();
+            break;
+        case MenuAction::ToggleMusic: {
+            bool turnOff = isMusicOn();
+            m_musicOn = !turnOff;
+            if (m_music) m_music->setVolume(turnOff ? 0.f : 100.f);
+            button.setLabel(turnOff ? "Off" : "On");
+            m_dirty = true;
+            break;
+        }
+        }
+    }
+
     void setupMainMenu() {
         m_staticTexts[MenuType::Main].clear();
         m_staticTexts[MenuType::Main].push_back(createStaticText("Space Ratao", width / 2, 100, 70, m_font));
         m_staticTexts[MenuType::Main].push_back(createStaticText("Version: Beta 1.0", 20, 720, 20, m_font, false));
         m_staticTexts[MenuType::Main].push_back(createStaticText("Made by Rodrigo Z Silveira", 20, 760, 20, m_font, false));
 
-        m_buttons[MenuType::Main].emplace_back("Start Game", width / 2, 300, m_font);
-        m_buttons[MenuType::Main].emplace_back("Options", width / 2, 400, m_font);
-        m_buttons[MenuType::Main].emplace_back("Exit", width / 2, 500, m_font);
+        m_buttons[MenuType::Main].emplace_back("Start Game", MenuAction::StartGame, width / 2, 300, m_font);
+        m_buttons[MenuType::Main].emplace_back("Options", MenuAction::Options, width / 2, 400, m_font);
+        m_buttons[MenuType::Main].emplace_back("Exit", MenuAction::Exit, width / 2, 500, m_font);
 
     }
 
@@ -616,8 +331,8 @@ private:
         m_staticTexts[MenuType::Options].push_back(createStaticText("Music:", 200, 300, 45, m_font));
 
         m_buttons[MenuType::Options].clear();
-        m_buttons[MenuType::Options].emplace_back("On", 600, 300, m_font);
-        m_buttons[MenuType::Options].emplace_back("Return", width / 2, 500, m_font);
+        m_buttons[MenuType::Options].emplace_back("On", MenuAction::ToggleMusic, 600, 300, m_font);
+        m_buttons[MenuType::Options].emplace_back("Return", MenuAction::Return, width / 2, 500, m_font);
 
     }
 
@@ -625,321 +340,455 @@ private:
         m_staticTexts[MenuType::Dead].clear();
         m_staticTexts[MenuType::Dead].push_back(createStaticText("You Died!", width / 2, 100, 70, m_font));
 
-        m_buttons[MenuType::Dead].emplace_back("Play Again", width / 2, 300, m_font);
-        m_buttons[MenuType::Dead].emplace_back("Options", width / 2, 400, m_font);
-        m_buttons[MenuType::Dead].emplace_back("Return to Menu", width / 2, 500, m_font);
+        m_buttons[MenuType::Dead].emplace_back("Play Again", MenuAction::StartGame, width / 2, 300, m_font);
+        m_buttons[MenuType::Dead].emplace_back("Options", MenuAction::Options, width / 2, 400, m_font);
+        m_buttons[MenuType::Dead].emplace_back("Return to Menu", MenuAction::ReturnToMenu, width / 2, 500, m_font);
 
     }
 };
 
-bool CheckCollision(sf::Sprite& object_1, sf::Sprite& object_2, float scaleFactor = 0.65f) {
-    // Get the global bounds of both objects
-    sf::FloatRect bounds1 = object_1.getGlobalBounds();
-    sf::FloatRect bounds2 = object_2.getGlobalBounds();
+const char* FONT_PATH = "Minecraft.ttf";
+const char* DEFAULT_PACK_PATH = "assets.pack";
+const char* DEFAULT_WAVES_PATH = "Waves/default.waves";
+const char* DEFAULT_MASKS_PATH = "SpriteMasks.h";
 
-    // Scale the size of the collision box (width and height)
-    bounds1.size *= scaleFactor;
-    bounds2.size *= scaleFactor;
-
-    // Check if the adjusted bounds intersect
-    if (!bounds1.findIntersection(bounds2)) {
-        return false;  // No intersection means no collision
+// Opens the font in place from the asset pack when it has it, which then has to outlive the font
+bool openFont(Font& font, const AssetPack& pack) {
+    if (const AssetPack::Entry* entry = pack.find(FONT_PATH)) {
+        return font.openFromMemory(entry->data, entry->size);
     }
-    return true;
+    return font.openFromFile(FONT_PATH);
 }
 
-int main() {
-    RenderWindow window(VideoMode({ width, height }, 24), "Spaceship", Style::Default);
-    window.setFramerateLimit(60);
+// Packs the sprite atlas and the font into one file the game maps at startup.
+// Run with --build-pack [path] after changing any of them.
+int buildAssetPack(const std::string& path) {
+    TextureAtlas::Packed atlas = TextureAtlas::pack(WorldRenderer::getSpritePaths());
 
-    Clock clock;
-
-    Music bg_music;
-    if (!bg_music.openFromFile("Audio/bg.ogg")) {
-        std::cerr << "ERROR: COULD NOT LOAD MUSIC: bg.ogg!\n";
+    AssetPackWriter writer;
+    writer.addImage(AssetPack::ATLAS, atlas.image);
+    for (const auto& region : atlas.regions) {
+        writer.addRegion(region.first, region.second);
+    }
+    if (!writer.addFile(FONT_PATH, FONT_PATH)) {
+        std::cerr << "ERROR: COULD NOT LOAD FONT: " << FONT_PATH << "!\n";
         return -1;
     }
-
-    // song randomizer
-    std::vector<Time> songStartTimes = {
-        seconds(0),     // Nebula Purple
-        seconds(239),   // Martian Red
-        seconds(461),   // Gamma Ray Yellow
-        seconds(572),   // Plasma Blue
-        seconds(811),   // Cosmic Dust Brown
-        seconds(920),   // Pulsar Green
-        seconds(1160),  // Quantum Indigo
-        seconds(1390),  // Asteroid Grey
-        seconds(1625),  // Quasar Gold
-        seconds(1800),  // Nebula Purple II
-        seconds(2039),  // Martian Red II
-        seconds(2261),  // Gamma Ray Yellow II
-        seconds(2372),  // Plasma Blue II
-        seconds(2611),  // Cosmic Dust Brown II
-        seconds(2720),  // Pulsar Green II
-        seconds(2960),  // Quantum Indigo II
-        seconds(3190),  // Asteroid Grey II
-        seconds(3425)   // Quasar Gold II
-    }; // individual song randomizer 
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-    int index = std::rand() % songStartTimes.size();
-
-    bg_music.setPlayingOffset(songStartTimes[index]);
-
-    bg_music.setLooping(true);
-    bg_music.play();
-
-
-    Font font;
-    if (!font.openFromFile("Minecraft.ttf")) {
-        std::cerr << "ERROR: COULD NOT LOAD FONT: Minecraft.ttf!\n";
+    if (!writer.saveToFile(path)) {
+        std::cerr << "ERROR: COULD NOT SAVE ASSET PACK: " << path << "\n";
         return -1;
     }
 
-    Timer timer(font);
-
-    Texture explosion_tex("Sprites/Explosion.png");
-    Texture spaceship_tex("Sprites/Spaceship3.png");
-    Texture life_tex("Sprites/Life.png");
-    Texture life_animation("Sprites/LifeAnimation.png");
-    Texture frieren_tex("Sprites/frierensprite.png");
-    Texture bullet_tex("Sprites/bullet1.png");
+    std::cout << "Packed " << atlas.regions.size() << " sprites (" << atlas.image.getSize().x << "x" << atlas.image.getSize().y
+              << " atlas) and " << FONT_PATH << " into " << path << "\n";
+    return 0;
+}
 
-    if (!frieren_tex.loadFromFile("Sprites/frierensprite.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/frierensprite.png" << std::endl;
-    }
-    if (!explosion_tex.loadFromFile("Sprites/Explosion.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/Explosion.png" << std::endl;
+// Writes SpriteMasks.h, the sprite sizes and collision masks headless runs use, from the sprite
+// files. Run with --dump-masks [path] after changing a sprite the simulation collides.
+int dumpSpriteMasks(const std::string& path) {
+    TextureAtlas::Packed atlas = TextureAtlas::pack(WorldRenderer::getSpritePaths());
+    std::ofstream file(path, std::ios::binary);
+    file << WorldRenderer::makeMaskSource(atlas);
+    if (!file) {
+        std::cerr << "ERROR: COULD NOT SAVE SPRITE MASKS: " << path << "\n";
+        return -1;
     }
-    if (!life_animation.loadFromFile("Sprites/LifeAnimation.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/LifeAnimation.png" << std::endl;
+    std::cout << "Wrote the sprite masks to " << path << "\n";
+    return 0;
+}
+
+// Times getting the startup assets (sprite atlas and font) ready from the loose files against
+// the asset pack. Run with --bench-startup [path]; the pack is built first if it's missing.
+int runStartupBenchmark(const std::string& packPath) {
+    if (!std::filesystem::exists(packPath) && buildAssetPack(packPath) != 0) {
+        return -1;
     }
-    if (!spaceship_tex.loadFromFile("Sprites/Spaceship3.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/Spaceship3.png" << std::endl;
+
+    const int RUNS = 20;
+    using BenchClock = std::chrono::steady_clock;
+    auto measure = [RUNS](const char* source, auto&& load) {
+        double best = 1e30, total = 0.0;
+        for (int run = 0; run < RUNS; ++run) {
+            auto start = BenchClock::now();
+            if (!load()) return -1.0;
+            double ms = std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+            best = std::min(best, ms);
+            total += ms;
+        }
+        std::printf("%-16s %12.2f %12.2f\n", source, total / RUNS, best);
+        return total / RUNS;
+    };
+
+    std::printf("startup: sprite atlas + font, %d runs each\n", RUNS);
+    std::printf("%-16s %12s %12s\n", "source", "avg (ms)", "best (ms)");
+
+    double loose = measure("loose files", [] {
+        TextureCache textures;
+        TextureAtlas atlas;
+        atlas.build(textures, WorldRenderer::getSpritePaths());
+        Font font;
+        return font.openFromFile(FONT_PATH);
+    });
+
+    double packed = measure(packPath.c_str(), [&packPath] {
+        AssetPack pack;
+        if (!pack.open(packPath)) return false;
+        TextureCache textures;
+        TextureAtlas atlas;
+        Font font;
+        return atlas.load(textures, pack, WorldRenderer::getSpritePaths()) && openFont(font, pack);
+    });
+
+    if (loose < 0.0 || packed < 0.0) {
+        std::cerr << "ERROR: COULD NOT LOAD STARTUP ASSETS\n";
+        return -1;
     }
-    if (!life_tex.loadFromFile("Sprites/Life.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/Life.png" << std::endl;
+    std::printf("speedup %.1fx\n", loose / packed);
+    return 0;
+}
+
+// Opens the soundtrack at a song picked from the seed. Runs on a loader thread, since it reads
+// file headers; null if there's no music to play.
+std::shared_ptr<MusicStream> openMusic(std::uint64_t seed) {
+    auto music = std::make_shared<MusicStream>();
+    if (!music->open(seed)) {
+        std::cerr << "ERROR: COULD NOT LOAD MUSIC: bg.ogg!\n";
+        return nullptr;
     }
-    if (!bullet_tex.loadFromFile("Sprites/bullet1.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/bullet1.png" << std::endl;
+    return music;
+}
+
+// Renders busy worlds into an offscreen texture and prints the draw calls each frame took.
+// Run with --check-draw-calls; the count must not grow with the number of entities.
+int runDrawCallCheck() {
+    RenderTexture target;
+    if (!target.resize({ width, height })) {
+        std::cerr << "ERROR: COULD NOT CREATE RENDER TEXTURE\n";
+        return -1;
     }
 
-    Texture* selectedTexture = nullptr;
-    Texture asteroid_Stex("Sprites/AsteroidSmall.png");
-    Texture asteroid_Mtex("Sprites/AsteroidMedium.png");
-    Texture asteroid_Ltex("Sprites/AsteroidLarge.png");
+    TextureCache textures;
+    WorldRenderer renderer(textures);
+    World world(renderer.makeConfig());
 
-    if (!asteroid_Stex.loadFromFile("Sprites/AsteroidSmall.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/AsteroidSmall.png" << std::endl;
-    }
-    if (!asteroid_Mtex.loadFromFile("Sprites/AsteroidMedium.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/AsteroidMedium.png" << std::endl;
-    }
-    if (!asteroid_Ltex.loadFromFile("Sprites/AsteroidLarge.png")) {
-        std::cerr << "ERROR: COULD NOT LOAD SPRITE: Sprites/AsteroidLarge.png" << std::endl;
+    InputFrame input;
+    input.fire = true;
+    input.aim = { width / 2.0f, 0.0f };
+
+    for (int tick = 1; tick <= 3000; ++tick) {
+        world.step(input);
+        if (world.isShipDestroyed()) world.reset();
+
+        if (tick % 600 == 0) {
+            target.clear();
+            renderer.draw(target, world);
+            target.display();
+
+            std::size_t sprites = 0;
+            for (int layer = 0; layer < WorldRenderer::LayerCount; ++layer) {
+                sprites += renderer.getSpriteCount(static_cast<WorldRenderer::Layer>(layer));
+            }
+            std::cout << "tick " << tick << ": " << sprites << " sprites, " << renderer.getParticleCount() << " particles, "
+                      << renderer.getDrawCallCount() << " draw calls\n";
+        }
     }
+    return 0;
+}
 
-    Spaceship spaceship(spaceship_tex, life_tex, life_animation);  // Create main Spaceship
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--check-draw-calls") {
+        return runDrawCallCheck();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--split-music") {
+        // Decodes and re-encodes the whole soundtrack, so it takes a while; done once offline
+        if (!SoundtrackSource::splitSoundtrack(MusicStream::SOUNDTRACK_PATH, MusicStream::TRACKS_DIRECTORY)) return -1;
+        std::cout << "Split " << MusicStream::SOUNDTRACK_PATH << " into " << MusicStream::TRACKS_DIRECTORY << "\n";
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--dump-masks") {
+        return dumpSpriteMasks(argc > 2 ? argv[2] : DEFAULT_MASKS_PATH);
+    }
+    if (argc > 1 && (std::string(argv[1]) == "--build-pack" || std::string(argv[1]) == "--bench-startup")) {
+        std::string path = argc > 2 ? argv[2] : DEFAULT_PACK_PATH;
+        return std::string(argv[1]) == "--build-pack" ? buildAssetPack(path) : runStartupBenchmark(path);
+    }
+
+    // A fresh seed every launch unless one is given; it's printed so a run can be replayed.
+    // --record saves every tick's input when the window closes, for SpaceGame-Headless --replay.
+    // --threaded runs the simulation on its own thread, decoupled from drawing and vsync.
+    // --pack loads sprites and the font from another asset pack than assets.pack.
+    // --waves plays another difficulty curve than Waves/default.waves.
+    std::uint64_t seed = static_cast<std::uint64_t>(std::time(nullptr));
+    std::string recordPath;
+    bool threaded = false;
+    std::string packPath = DEFAULT_PACK_PATH;
+    std::string wavesPath = DEFAULT_WAVES_PATH;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (option == "--record" && hasValue) recordPath = argv[++i];
+        else if (option == "--threaded") threaded = true;
+        else if (option == "--pack" && hasValue) packPath = argv[++i];
+        else if (option == "--waves" && hasValue) wavesPath = argv[++i];
+    }
+    std::cout << "Seed: " << seed << "\n";
+    auto startupBegin = std::chrono::steady_clock::now();
+    auto sinceStartup = [&startupBegin] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
+    };
+
+    RenderWindow window(VideoMode({ width, height }, 24), "Spaceship", Style::Default);
+    window.setVerticalSyncEnabled(true);
 
-    int spawnCounter = 0;
-    float asteroid_spawn_time = ASTEROID_SPAWN_TIME;
-    float bullet_cooldown = 0.5f;
+    Clock clock;
+
+    // Without a pack (or with a stale one) everything is decoded from the loose files instead
+    AssetPack pack;
+    if (pack.open(packPath)) {
+        std::cout << "Assets: " << packPath << "\n";
+    }
+    else {
+        std::cout << "Assets: loose files (no " << packPath << ", build one with --build-pack)\n";
+    }
 
-    std::vector<Asteroid> asteroids;
-    std::vector<Asteroid> menuAsteroids;
-    std::vector<Animation> explosions;
-    std::vector<Animation> hexplosions;
-    std::vector<Bullet> bullets;
+    Font font;
+    if (!openFont(font, pack)) {
+        std::cerr << "ERROR: COULD NOT LOAD FONT: Minecraft.ttf!\n";
+        return -1;
+    }
 
-    Menu menu(window, font, bg_music);
+    // The music and (without a pack holding every sprite) the sprites load in the background
+    // while the menu is already up; the game starts once the sprites are there
+    AssetLoader loader;
+    AssetHandle<MusicStream> musicHandle = loader.load<MusicStream>([seed] { return openMusic(seed); });
+    AssetHandle<TextureAtlas::Packed> atlasHandle;
+    if (!TextureAtlas::hasAtlas(pack, WorldRenderer::getSpritePaths())) {
+        if (pack.find(AssetPack::ATLAS)) {
+            std::cout << "Assets: " << packPath << " is missing sprites, loading them from the loose files (rebuild it with --build-pack)\n";
+        }
+        atlasHandle = loader.load<TextureAtlas::Packed>([] {
+            return std::make_shared<TextureAtlas::Packed>(TextureAtlas::pack(WorldRenderer::getSpritePaths()));
+        });
+    }
+
+    Menu menu(window, font);
+    std::shared_ptr<MusicStream> bg_music;
+    std::size_t shownLoads = 0;
+    auto updateLoading = [&] {
+        if (!bg_music && musicHandle.isReady()) {
+            bg_music = musicHandle.wait();
+            if (bg_music) {
+                menu.setMusic(bg_music.get());
+                bg_music->play();
+            }
+        }
+        if (loader.getCompletedCount() != shownLoads) {
+            shownLoads = loader.getCompletedCount();
+            menu.setStatus(loader.isIdle() ? "" : "Loading " + std::to_string(shownLoads) + "/" + std::to_string(loader.getSubmittedCount()));
+        }
+    };
+    menu.setStatus("Loading 0/" + std::to_string(loader.getSubmittedCount()));
+
+    bool firstFrame = true;
+    auto noteFirstFrame = [&] {
+        if (!firstFrame) return;
+        std::cout << "Startup: menu shown after " << sinceStartup() << " ms\n";
+        firstFrame = false;
+    };
+    while (window.isOpen() && atlasHandle.isValid() && !atlasHandle.isReady()) {
+        // Short timeout so progress shows up while the mouse is still
+        if (const std::optional event = window.waitEvent(milliseconds(10))) {
+            if (event->is<Event::Closed>()) window.close();
+            menu.handleEvent(*event);
+        }
+        while (const std::optional event = window.pollEvent()) {
+            if (event->is<Event::Closed>()) window.close();
+            menu.handleEvent(*event);
+        }
+        updateLoading();
+        menu.render();
+        noteFirstFrame();
+    }
+    if (!window.isOpen()) return 0;
+
+    TextureCache textures;
+    TextureAtlas atlas;
+    if (!atlas.load(textures, pack, WorldRenderer::getSpritePaths())) {
+        std::shared_ptr<TextureAtlas::Packed> packed = atlasHandle.wait();
+        atlas.upload(textures, *packed);
+    }
+    WorldRenderer renderer(std::move(atlas));
+    std::cout << "Startup: sprites ready after " << sinceStartup() << " ms\n";
+    Hud hud(font, renderer.getAtlasTexture(), renderer.getLifeRegion());
+    Clock playClock;
+    WorldConfig config = renderer.makeConfig();
+    config.seed = seed;
+    if (!config.waves.loadFromFile(wavesPath)) {
+        std::cerr << "ERROR: COULD NOT LOAD WAVES: " << wavesPath << ", USING THE BUILT-IN ONES!\n";
+    }
+    World world(config);
+    JobSystem jobs;
+    world.setJobSystem(&jobs);
+    InputRecording recording;
+    recording.start(seed, config.tickRate);
+    std::cout << "Textures: " << textures.getTextureCount() << " loaded, " << textures.getUploadCount() << " GPU uploads\n";
+
+    // Frame profiler; F3 shows its overlay
+    Profiler profiler;
+    const int pollZone = profiler.addZone("poll-input");
+    const int stepZone = profiler.addZone("update");
+    const int drawZone = profiler.addZone("draw");
+    const int menuZone = profiler.addZone("menu");
+    if (!threaded) world.setProfiler(&profiler);   // The profiler belongs to this thread
+    renderer.setProfiler(&profiler);
+    ProfilerOverlay overlay(font);
+    bool showOverlay = false;
+
+    menu.setProfiler(&profiler, menuZone);
     MenuType type = MenuType::Main;
 
+    // Real time not yet simulated. Frames add to it and whole ticks are taken out of it, so the
+    // game runs at the same speed whatever the framerate.
+    float accumulator = 0.0f;
+    const float tickSeconds = world.getTickSeconds();
+    const float MAX_FRAME_TIME = 0.25f; // Don't try to catch up after a long stall
+
+    // Threaded mode: input goes to the simulation thread through one triple buffer and
+    // snapshots come back through another; this thread never touches the world while it runs
+    TripleBuffer<InputFrame> inputs;
+    SimulationThread::Options simulationOptions;
+    SimulationThread simulation(world, [&](std::uint64_t) {
+        inputs.update();
+        InputFrame input = inputs.getFront();
+        if (!recordPath.empty()) recording.record(input);
+        return input;
+    }, simulationOptions);
+    std::uint64_t deathsSeen = 0;
+    if (threaded) {
+        simulation.pause();
+        simulation.start();
+    }
 
     while (window.isOpen()) {
         Time deltaTime = clock.restart();
-        while (const std::optional event = window.pollEvent()) {
-            if (event->is<Event::Closed>())
-                window.close();
+        profiler.beginFrame();
+        updateLoading();
+
+        InputFrame input;
+        {
+            ProfileZone zone(&profiler, pollZone);
+            auto handleEvent = [&](const Event& event) {
+                if (event.is<Event::Closed>())
+                    window.close();
+                else if (const auto* key = event.getIf<Event::KeyPressed>()) {
+                    if (key->scancode == Keyboard::Scan::F3) showOverlay = !showOverlay;
+                }
+                menu.handleEvent(event);
+            };
+
+            // Nothing on a menu changes by itself, so an idle menu sleeps until there's input.
+            // The timeout keeps the loop (and the profiler) ticking over now and then.
+            if (!menu.isGameStarted() && !menu.needsRedraw()) {
+                if (const std::optional event = window.waitEvent(milliseconds(100))) {
+                    handleEvent(*event);
+                }
+            }
+            while (const std::optional event = window.pollEvent()) {
+                handleEvent(*event);
+            }
+
+            input.up = Keyboard::isKeyPressed(Keyboard::Scan::W);
+            input.down = Keyboard::isKeyPressed(Keyboard::Scan::S);
+            input.left = Keyboard::isKeyPressed(Keyboard::Scan::A);
+            input.right = Keyboard::isKeyPressed(Keyboard::Scan::D);
+            input.aim = Vector2f(Mouse::getPosition(window));
+            input.fire = Mouse::isButtonPressed(Mouse::Button::Left);
         }
 
         if (!menu.isGameStarted()) {
-            menu.handleClick();
             menu.render();
-            timer.reset();
+            noteFirstFrame();
+            playClock.restart();
+            accumulator = 0.0f;
+            if (threaded) simulation.pause();
         }
 
         // Game started
         if (menu.isGameStarted()) {
-            if(menu.isMusicOn()) bg_music.setVolume(70);
-            Vector2i mousePos = Mouse::getPosition(window); // Spaceship update
-            spaceship.handleMouseInput(mousePos);
-            spaceship.handleKBInput();
-            spaceship.update();
-            timer.update();
-            asteroid_spawn_time -= 0.1f;
-            bullet_cooldown -= 0.1f;
-
-            // Handle Asteroid - Spaceship collision
-            for (auto it = asteroids.begin(); it != asteroids.end(); ) {
-                if (spaceship.canCollide() && CheckCollision(spaceship.getSprite(), it->getSprite())) {
-                    spaceship.Collision();
-
-                    // Create explosion at the asteroid's position
-                    explosions.emplace_back(explosion_tex, it->getSprite().getPosition(), 6, 25, 25);
-
-                    // Create Heart loosing animation
-                    if (spaceship.getLives() > 0) {
-                        float heartPosX = 20.0f + ((spaceship.getLives()) * 40.0f);  // Position of last heart
-                        float heartPosY = height - 50.0f;  // Consistent Y position
-                        hexplosions.emplace_back(life_animation, sf::Vector2f(heartPosX, heartPosY), 5, 10, 10);
-                    }
+            if(bg_music && menu.isMusicOn()) bg_music->setVolume(70);
 
-                    // Remove asteroid from the vector
-                    it = asteroids.erase(it);
-                }
-                else {
-                    it->update();
-                    ++it;
+            if (threaded) {
+                inputs.getBack() = input;
+                inputs.publish();
+
+                simulation.updateSnapshot();
+                if (!simulation.resume(deathsSeen)) {
+                    deathsSeen = simulation.getDeaths();
+                    menu.setMenuType(MenuType::Dead);
+                    menu.setGameStarted(false);
                 }
             }
-
-            // Handle Asteroid - Bullets collision
-            for (auto bulletIt = bullets.begin(); bulletIt != bullets.end(); ) {
-                bool bulletDestroyed = false; // Track if the bullet is destroyed
-
-                for (auto asteroidIt = asteroids.begin(); asteroidIt != asteroids.end(); ) {
-                    if (CheckCollision(bulletIt->getSprite(), asteroidIt->getSprite())) {
-                        // Create explosion at asteroid's position
-                        explosions.emplace_back(explosion_tex, asteroidIt->getSprite().getPosition(), 6, 25, 25);
-
-                        // Erase asteroid from vector
-                        asteroidIt = asteroids.erase(asteroidIt);
-
-                        // Erase bullet and break out of asteroid loop
-                        bulletIt = bullets.erase(bulletIt);
-                        bulletDestroyed = true;
+            else {
+                ProfileZone zone(&profiler, stepZone);
+                accumulator += std::min(deltaTime.asSeconds(), MAX_FRAME_TIME);
+                while (accumulator >= tickSeconds) {
+                    if (!recordPath.empty()) recording.record(input);
+                    world.step(input);
+                    accumulator -= tickSeconds;
+
+                    if (world.isShipDestroyed()) {
+                        menu.setMenuType(MenuType::Dead);
+                        menu.setGameStarted(false);
+                        world.reset();
+                        accumulator = 0.0f;
                         break;
                     }
-                    else {
-                        ++asteroidIt;
-                    }
-                }
-
-                // If the bullet was destroyed, we already erased it, so continue the loop
-                if (!bulletDestroyed) {
-                    ++bulletIt;
-                }
-            }
-
-            // Update bullets
-            for (auto& bullet : bullets) {
-                bullet.update();
-            }
-
-            // Removes finished explosions
-            for (auto it = explosions.begin(); it != explosions.end(); ) {
-                it->update();
-                if (it->isFinished()) {
-                    it = explosions.erase(it);
-                }
-                else {
-                    ++it;
-                }
-            }
-
-            // Removes finished heart animations
-            for (auto it = hexplosions.begin(); it != hexplosions.end(); ) {
-                it->update();
-                if (it->isFinished()) {
-                    it = hexplosions.erase(it);
-                }
-                else {
-                    ++it;
                 }
             }
 
-            // Spawn new asteroids
-            if (asteroid_spawn_time <= 0.0f) {
-                spawnCounter++;
-                bool large = false;
-                if (spawnCounter % 3 == 0) {
-                    selectedTexture = &asteroid_Stex;
-                }
-                else if (spawnCounter % 3 == 1) {
-                    selectedTexture = &asteroid_Mtex;
+            {
+                ProfileZone zone(&profiler, drawZone);
+                window.clear();
+                if (threaded) {
+                    // How far real time has moved on from the latest tick
+                    const RenderSnapshot& snapshot = simulation.getSnapshot();
+                    float sincePublished = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot.publishedAt).count();
+                    renderer.draw(window, snapshot, std::min(sincePublished / tickSeconds, 1.0f));
+                    hud.update(playClock.getElapsedTime().asSeconds(), snapshot.lives);
                 }
                 else {
-                    selectedTexture = &asteroid_Ltex;
-                    large = true;
+                    renderer.draw(window, world, accumulator / tickSeconds);
+                    hud.update(playClock.getElapsedTime().asSeconds(), world.getSpaceship().getLives());
                 }
-
-                Asteroid newAsteroid(*selectedTexture, 3.5f, 4.5f, large);
-                newAsteroid.appear(width, height);
-                asteroids.push_back(newAsteroid);
-                asteroid_spawn_time = ASTEROID_SPAWN_TIME;
-            }
-
-            // Removes out-of-screen asteroids
-            for (auto it = asteroids.begin(); it != asteroids.end(); ) {
-                it->update();
-                if (it->isOutOfScreen(width, height)) {
-                    it = asteroids.erase(it);
-                }
-                else {
-                    ++it;
+                hud.draw(window);
+                if (showOverlay) {
+                    overlay.update(profiler, hud.getCounters());
+                    overlay.draw(window);
                 }
+                window.display();
             }
+        }
 
-            // Checks for bullets shooted
-            if (Mouse::isButtonPressed(Mouse::Button::Left) && bullet_cooldown <= 0.0f) {
-                float spaceshipAngle = spaceship.getSprite().getRotation().asDegrees(); // Get rotation in degrees
-
-                // Get spaceship tip position
-                sf::Vector2f spaceshipPos = spaceship.getSprite().getPosition();
-                float spaceshipLength = spaceship.getSprite().getGlobalBounds().size.y / 2.0f; // Half of the spaceship height (assuming it's vertical)
-
-                // Convert angle to radians for offset calculation
-                float radian = (spaceshipAngle - 90) * 3.14159f / 180.0f;
-
-                // Calculate tip position
-                sf::Vector2f bulletSpawnPos = spaceshipPos + sf::Vector2f(std::cos(radian) * spaceshipLength, std::sin(radian) * spaceshipLength);
-
-                // Spawn bullet at the tip
-                bullets.emplace_back(bullet_tex, bulletSpawnPos, spaceshipAngle);
-                bullet_cooldown = 0.5f;
-            }
-
-            if (spaceship.getLives() <= 0) {
-                menu.setMenuType(MenuType::Dead);
-                menu.setGameStarted(false);
-                spaceship.reset();
-                asteroids.clear();
-            }
-
-            window.clear();
-            spaceship.draw(window);
-            timer.draw(window);
-
-            // Draw asteroids
-            for (auto& asteroid : asteroids) {
-                asteroid.draw(window);
-            }
-
-            for (auto& bullets : bullets) {
-                bullets.draw(window);
-            }
-
-            // Draw explosions
-            for (auto& explosion : explosions) {
-                explosion.draw(window);
-            }
+        if (threaded) {
+            const RenderSnapshot& snapshot = simulation.getSnapshot();
+            profiler.endFrame({ snapshot.asteroids.size(), snapshot.bullets.size(), snapshot.explosions.size() + snapshot.hearts.size() });
+        }
+        else {
+            profiler.endFrame(world.getCounts());
+        }
+    }
 
-            for (auto& hexplosion : hexplosions) {
-                hexplosion.draw(window);
-            }
+    simulation.stop();
 
-            window.display();
+    if (!recordPath.empty()) {
+        recording.finish(world.stateHash());
+        if (!recording.saveToFile(recordPath)) {
+            std::cerr << "ERROR: COULD NOT SAVE INPUT RECORDING: " << recordPath << "\n";
+            return -1;
         }
+        std::cout << "Recorded " << recording.getTickCount() << " ticks to " << recordPath << "\n";
     }
 
     return 0;